@@ -0,0 +1,475 @@
+/*
+    Benchmark suite for the Graph.cpp engines
+
+    Usage:
+        g++ -std=c++17 -O2 -pthread Library/Benchmark.cpp -o benchmark
+        ./benchmark [maxExp = 6] [seed = 1] [filter = ""]
+
+        - every engine runs on every size m = 10^4, 10^5, ..., 10^maxExp edges (n = m / 4 nodes), the
+        tree and chain cases on n = 10^4, 10^5, ..., 10^maxExp nodes instead
+        - only engines whose name contains filter are run
+        - the LowestCommonAncestor cases answer lcaQueries = 10^7 random queries on every tree size, once per
+        mode (SparseTable, BlockRMQ, Offline), run_seconds covers Build() and all the queries, and the
+        query batch counts towards peak_rss_kb
+        - every case runs in a forked child, so that peak RSS is measured per case
+        - output is one JSON object per line:
+            {"engine": ..., "generator": ..., "n": ..., "m": ..., "seed": ...,
+             "build_seconds": ..., "run_seconds": ..., "edges_per_second": ..., "input_rss_kb": ...,
+             "peak_rss_kb": ..., "check": ...}
+          query cases report "queries": ..., "queries_per_second": ... instead of edges_per_second
+          build_seconds covers the AddEdge() calls, run_seconds the algorithm itself, and check is an
+          engine specific value (number of components, flow value, ...) to compare runs
+          input_rss_kb is the RSS once the input is generated, peak_rss_kb is how much the engine grows
+          the peak RSS on top of that (the peak is reset through /proc/self/clear_refs where available)
+
+    Generators (all seeded, deterministic):
+        - Random, G(n, m) with m uniformly random directed edges
+        - Grid, sqrt(n) x sqrt(n) grid with random weights
+        - PowerLaw, Chung-Lu graph with expected degrees following a power law (exponent ~2.5)
+        - Layered, flow network of source -> layers of width sqrt(n) -> sink
+        - Bipartite, random bipartite graph with n / 2 nodes on each side
+        - DAG, random edges from lower to higher index, plus a spanning path from 0
+        - ClosedWalk, random closed walk, always Eulerian and connected
+        - Tree, random recursive tree
+        - Chain, a single path 0 -> 1 -> ... -> n - 1
+*/
+
+#include <bits/stdc++.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+using namespace std;
+
+#define x first
+#define y second
+
+typedef long long ll;
+typedef pair<int, int> PI;
+
+const int inf = 2000000000;
+
+#include "Utility.cpp"
+#include "DS.cpp"
+#include "Graph.cpp"
+
+struct Edges {
+    string name;
+    int n;
+    vector <int> from, to, weight;
+
+    Edges (const string& name, int n): name(name), n(n) {}
+
+    void Add (int a, int b, int w = 1) {
+        from.push_back(a), to.push_back(b), weight.push_back(w);
+    }
+
+    size_t size () const {
+        return from.size();
+    }
+};
+
+namespace Generator {
+    Edges Random (int n, long long m, mt19937_64& rng) {
+        Edges E("random", n);
+        for (long long i = 0; i < m; ++i) {
+            E.Add(rng() % n, rng() % n, 1 + rng() % 1000);
+        }
+        return E;
+    }
+
+    Edges Grid (int n, long long, mt19937_64& rng) {
+        int k = max(2, int(sqrt(double(n))));
+        Edges E("grid", k * k);
+        for (int i = 0; i < k; ++i) {
+            for (int j = 0; j < k; ++j) {
+                if (i + 1 < k) {
+                    E.Add(i * k + j, (i + 1) * k + j, 1 + rng() % 1000);
+                }
+                if (j + 1 < k) {
+                    E.Add(i * k + j, i * k + j + 1, 1 + rng() % 1000);
+                }
+            }
+        }
+        return E;
+    }
+
+    Edges PowerLaw (int n, long long m, mt19937_64& rng) {
+        Edges E("powerlaw", n);
+        vector <double> prefix(n + 1, 0);
+        for (int i = 0; i < n; ++i) {
+            prefix[i + 1] = prefix[i] + pow(i + 1.0, -1.0 / 1.5);
+        }
+        uniform_real_distribution <double> U(0, prefix[n]);
+        auto pick = [&]() {
+            return int(upper_bound(prefix.begin(), prefix.end(), U(rng)) - prefix.begin()) - 1;
+        };
+        for (long long i = 0; i < m; ++i) {
+            E.Add(pick(), pick(), 1 + rng() % 1000);
+        }
+        return E;
+    }
+
+    // node 0 is the source, node n - 1 the sink
+    Edges Layered (int n, long long m, mt19937_64& rng) {
+        int width = max(1, int(sqrt(double(n)))), layers = max(1, (n - 2) / width);
+        Edges E("layered", layers * width + 2);
+        int t = layers * width + 1;
+        long long per = max(1LL, m / max(1, layers - 1));
+        for (int j = 0; j < width; ++j) {
+            E.Add(0, 1 + j, inf / 2);
+            E.Add(1 + (layers - 1) * width + j, t, inf / 2);
+        }
+        for (int l = 0; l + 1 < layers; ++l) {
+            for (long long i = 0; i < per; ++i) {
+                E.Add(1 + l * width + rng() % width, 1 + (l + 1) * width + rng() % width, 1 + rng() % 1000);
+            }
+        }
+        return E;
+    }
+
+    // left side 1..n/2, right side 1..n/2, HopcroftKarp indexing
+    Edges Bipartite (int n, long long m, mt19937_64& rng) {
+        Edges E("bipartite", max(1, n / 2));
+        for (long long i = 0; i < m; ++i) {
+            E.Add(1 + rng() % E.n, 1 + rng() % E.n);
+        }
+        return E;
+    }
+
+    Edges DAG (int n, long long m, mt19937_64& rng) {
+        Edges E("dag", n);
+        for (int i = 0; i + 1 < n; ++i) {
+            E.Add(i, i + 1);
+        }
+        for (long long i = n - 1; i < m; ++i) {
+            int a = rng() % n, b = rng() % n;
+            if (a != b) {
+                E.Add(min(a, b), max(a, b));
+            }
+        }
+        return E;
+    }
+
+    Edges ClosedWalk (int n, long long m, mt19937_64& rng) {
+        Edges E("closedwalk", n);
+        int first = 0, u = 0;
+        for (long long i = 0; i + 1 < m; ++i) {
+            int v = rng() % n;
+            E.Add(u, v);
+            u = v;
+        }
+        E.Add(u, first);
+        return E;
+    }
+
+    Edges Tree (int n, long long, mt19937_64& rng) {
+        Edges E("tree", n);
+        for (int i = 1; i < n; ++i) {
+            E.Add(rng() % i, i);
+        }
+        return E;
+    }
+
+    Edges Chain (int n, long long, mt19937_64&) {
+        Edges E("chain", n);
+        for (int i = 0; i + 1 < n; ++i) {
+            E.Add(i, i + 1);
+        }
+        return E;
+    }
+};
+
+/*
+    A benchmark case: build (E) feeds the engine, run () returns the check value
+*/
+
+struct Case {
+    string engine;
+    function <Edges (int, long long, mt19937_64&)> generate;
+    function <long long (const Edges&)> measure;
+    // sizes are node counts instead of edge counts (trees and chains)
+    bool byNodes = false;
+    // number of queries run_seconds is spent on, 0 if the case measures the edges
+    long long queries = 0;
+};
+
+// value in kB of a line like "VmRSS:  1234 kB" of /proc/self/status, -1 if unavailable
+long ProcStatus (const char *key) {
+    FILE *f = fopen("/proc/self/status", "r");
+    long value = -1;
+    char line[256];
+    while (f && fgets(line, sizeof(line), f)) {
+        if (strncmp(line, key, strlen(key)) == 0) {
+            value = atol(line + strlen(key) + 1);
+        }
+    }
+    if (f) {
+        fclose(f);
+    }
+    return value;
+}
+
+// resets the peak RSS to the current RSS (so transient peaks of the generator don't count) and returns it
+long ResetPeakRSS () {
+    FILE *f = fopen("/proc/self/clear_refs", "w");
+    if (f) {
+        fputs("5", f);
+        fclose(f);
+    }
+    long rss = ProcStatus("VmRSS");
+    if (rss < 0) {
+        rusage usage;
+        getrusage(RUSAGE_SELF, &usage);
+        rss = usage.ru_maxrss;
+    }
+    return rss;
+}
+
+long PeakRSS () {
+    long peak = ProcStatus("VmHWM");
+    if (peak < 0) {
+        rusage usage;
+        getrusage(RUSAGE_SELF, &usage);
+        peak = usage.ru_maxrss;
+    }
+    return peak;
+}
+
+double Now () {
+    return chrono::duration <double>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// timings of the current case, set by the measure functions
+double buildSeconds, runSeconds;
+
+template <class Build, class Run> long long Measure (Build build, Run run) {
+    double t0 = Now();
+    build();
+    double t1 = Now();
+    long long check = run();
+    double t2 = Now();
+    buildSeconds = t1 - t0, runSeconds = t2 - t1;
+    return check;
+}
+
+// number of random queries of the LowestCommonAncestor cases, independent of the tree size
+const int lcaQueries = 10000000;
+
+// online modes run Build() and answer the batch with Query(), the offline mode runs Offline() on the same batch
+template <class RMQ> long long MeasureLCA (const Edges& E, bool offline) {
+    LowestCommonAncestor <RMQ> L(E.n);
+    vector <pair <int, int>> queries(lcaQueries);
+    mt19937 rng(E.n);
+    for (auto& q : queries) {
+        q = make_pair(rng() % E.n, rng() % E.n);
+    }
+    vector <int> answers;
+    return Measure([&]() {
+        for (size_t i = 0; i < E.size(); ++i) {
+            L.AddEdge(E.from[i], E.to[i]);
+        }
+    }, [&]() {
+        if (offline) {
+            L.Offline(queries, answers, 0);
+        } else {
+            L.Build(0);
+            L.Query(queries, answers);
+        }
+        return accumulate(answers.begin(), answers.end(), 0LL);
+    });
+}
+
+vector <Case> Cases () {
+    vector <Case> cases;
+
+    cases.push_back({"StronglyConnectedComponents", Generator::Random, [](const Edges& E) {
+        StronglyConnectedComponents S(E.n);
+        return Measure([&]() {
+            for (size_t i = 0; i < E.size(); ++i) {
+                S.AddEdge(E.from[i], E.to[i]);
+            }
+        }, [&]() {
+            S.BuildSCC();
+            return (long long) S.totalComponents;
+        });
+    }});
+
+    cases.push_back({"StronglyConnectedComponents", Generator::PowerLaw, cases.back().measure});
+
+    cases.push_back({"BiconnectedComponents", Generator::Random, [](const Edges& E) {
+        BiconnectedComponents B(E.n);
+        return Measure([&]() {
+            for (size_t i = 0; i < E.size(); ++i) {
+                B.AddEdge(E.from[i], E.to[i]);
+            }
+        }, [&]() {
+            B.BuildBCC();
+            return (long long) B.components.size();
+        });
+    }});
+
+    cases.push_back({"BiconnectedComponents", Generator::Grid, cases.back().measure});
+
+    cases.push_back({"Kruskal", Generator::Random, [](const Edges& E) {
+        Kruskal <long long> K(E.n);
+        return Measure([&]() {
+            for (size_t i = 0; i < E.size(); ++i) {
+                K.AddEdge(E.from[i], E.to[i], E.weight[i]);
+            }
+        }, [&]() {
+            return K.MST();
+        });
+    }});
+
+    cases.push_back({"Kruskal", Generator::Grid, cases.back().measure});
+
+    cases.push_back({"Dijkstra", Generator::Random, [](const Edges& E) {
+        Dijkstra <long long> D(E.n, true);
+        return Measure([&]() {
+            for (size_t i = 0; i < E.size(); ++i) {
+                D.addEdge(E.from[i], E.to[i], E.weight[i]);
+            }
+        }, [&]() {
+            vector <long long> dist;
+            D.BuildTree(0, dist);
+            return (long long) count_if(dist.begin(), dist.end(), [](long long d) {
+                return d < inf;
+            });
+        });
+    }});
+
+    cases.push_back({"Dijkstra", Generator::Grid, cases.back().measure});
+
+    cases.push_back({"HopcroftKarp", Generator::Bipartite, [](const Edges& E) {
+        HopcroftKarp H(E.n, E.n);
+        return Measure([&]() {
+            for (size_t i = 0; i < E.size(); ++i) {
+                H.AddEdge(E.from[i], E.to[i]);
+            }
+        }, [&]() {
+            return (long long) H.Match();
+        });
+    }});
+
+    cases.push_back({"PushRelabel", Generator::Layered, [](const Edges& E) {
+        PushRelabel <long long> P(E.n);
+        return Measure([&]() {
+            for (size_t i = 0; i < E.size(); ++i) {
+                P.AddEdge(E.from[i], E.to[i], E.weight[i]);
+            }
+        }, [&]() {
+            return P.GetMaxFlow(0, E.n - 1);
+        });
+    }});
+
+    cases.push_back({"EulerTour", Generator::ClosedWalk, [](const Edges& E) {
+        EulerTour T(E.n);
+        return Measure([&]() {
+            for (size_t i = 0; i < E.size(); ++i) {
+                T.AddEdge(E.from[i], E.to[i], true);
+            }
+        }, [&]() {
+            T.StartTour(0);
+            return (long long) T.tour.size();
+        });
+    }});
+
+    cases.push_back({"TopologicalSort", Generator::DAG, [](const Edges& E) {
+        TopologicalSort T(E.n);
+        return Measure([&]() {
+            for (size_t i = 0; i < E.size(); ++i) {
+                T.AddEdge(E.from[i], E.to[i]);
+            }
+        }, [&]() {
+            T.Sort();
+            return (long long) T.sorted.size();
+        });
+    }});
+
+    cases.push_back({"LowestCommonAncestor/SparseTable", Generator::Tree, [](const Edges& E) {
+        return MeasureLCA <SparseTableRMQ <int>>(E, false);
+    }, true, lcaQueries});
+
+    cases.push_back({"LowestCommonAncestor/BlockRMQ", Generator::Tree, [](const Edges& E) {
+        return MeasureLCA <BlockRMQ <int>>(E, false);
+    }, true, lcaQueries});
+
+    cases.push_back({"LowestCommonAncestor/Offline", Generator::Tree, [](const Edges& E) {
+        return MeasureLCA <SparseTableRMQ <int>>(E, true);
+    }, true, lcaQueries});
+
+    cases.push_back({"DominatorTree", Generator::Chain, [](const Edges& E) {
+        DominatorTree D(E.n);
+        return Measure([&]() {
+            for (size_t i = 0; i < E.size(); ++i) {
+                D.AddEdge(E.from[i], E.to[i]);
+            }
+        }, [&]() {
+            D.Build(0);
+            return (long long) D.idom[E.n - 1];
+        });
+    }, true});
+
+    cases.push_back({"DominatorTree", Generator::DAG, cases.back().measure});
+
+    return cases;
+}
+
+int main(int argc, char const *argv[]) {
+    int maxExp = argc > 1 ? atoi(argv[1]) : 6;
+    unsigned long long seed = argc > 2 ? atoll(argv[2]) : 1;
+    string filter = argc > 3 ? argv[3] : "";
+
+    // recursive engines (SCC, BCC, TopologicalSort, ...) need a deep stack on large inputs
+    rlimit stack;
+    getrlimit(RLIMIT_STACK, &stack);
+    stack.rlim_cur = stack.rlim_max;
+    setrlimit(RLIMIT_STACK, &stack);
+
+    for (auto& c : Cases()) {
+        if (c.engine.find(filter) == string::npos) {
+            continue;
+        }
+        long long m = 1;
+        for (int e = 0; e < 4; ++e) {
+            m *= 10;
+        }
+        for (int e = 4; e <= maxExp; ++e, m *= 10) {
+            fflush(stdout);
+            pid_t pid = fork();
+            if (pid == 0) {
+                mt19937_64 rng(seed);
+                Edges E = c.byNodes ? c.generate(m, m - 1, rng) : c.generate(max(2LL, m / 4), m, rng);
+                // the input stays resident during the case, so the engine's memory is the growth of the peak
+                long input = ResetPeakRSS();
+                long long check = c.measure(E);
+                long peak = PeakRSS();
+                char rate[96];
+                if (c.queries) {
+                    snprintf(rate, sizeof(rate), "\"queries\": %lld, \"queries_per_second\": %.0f",
+                             c.queries, c.queries / max(runSeconds, 1e-9));
+                } else {
+                    snprintf(rate, sizeof(rate), "\"edges_per_second\": %.0f", E.size() / max(runSeconds, 1e-9));
+                }
+                printf("{\"engine\": \"%s\", \"generator\": \"%s\", \"n\": %d, \"m\": %zu, \"seed\": %llu, "
+                       "\"build_seconds\": %.6f, \"run_seconds\": %.6f, %s, "
+                       "\"input_rss_kb\": %ld, \"peak_rss_kb\": %ld, \"check\": %lld}\n",
+                       c.engine.c_str(), E.name.c_str(), E.n, E.size(), seed, buildSeconds, runSeconds,
+                       rate, input, peak - input, check);
+                fflush(stdout);
+                _exit(0);
+            }
+            int status;
+            waitpid(pid, &status, 0);
+            if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+                printf("{\"engine\": \"%s\", \"m\": %lld, \"seed\": %llu, \"error\": \"child exited with status %d\"}\n",
+                       c.engine.c_str(), m, seed, status);
+            }
+        }
+    }
+    return 0;
+}
@@ -110,68 +110,547 @@ struct DisjointSet {
     }
 };
 
+/*
+    Implementation of disjoint-set data structure in a single packed array, without recursion
+
+    Running time:
+        O(⍺(n)) amortized per operation, union by size with path halving
+
+    Usage:
+        - Find (x) returns the set containing x
+        - Union (x, y) joins two sets containing x and y, returns false if x and y are in the same set
+        - Size (x) returns the size of the set containing x
+
+    Input:
+        - n, number of sets
+
+    Output:
+        - parent, parent[x] < 0 iff x is a root, and then -parent[x] is the size of its set
+*/
+
+struct PackedDisjointSet {
+    int n;
+    vector <int> parent;
+
+    PackedDisjointSet (int n): n(n), parent(n, -1) {}
+
+    int Find (int x) {
+        while (parent[x] >= 0) {
+            if (parent[parent[x]] >= 0) {
+                parent[x] = parent[parent[x]];
+            }
+            x = parent[x];
+        }
+        return x;
+    }
+
+    bool Union (int x, int y) {
+        x = Find(x), y = Find(y);
+        if (x == y) {
+            return false;
+        }
+        if (parent[x] > parent[y]) {
+            swap(x, y);
+        }
+        parent[x] += parent[y];
+        parent[y] = x;
+        return true;
+    }
+
+    int Size (int x) {
+        return -parent[Find(x)];
+    }
+};
+
+/*
+    Implementation of lock-free concurrent disjoint-set data structure
+
+    Running time:
+        O(log(n)) expected per operation, linking by a random priority of the roots with
+        compare-and-swap, and path halving with compare-and-swap
+
+    Usage:
+        - every method can be called from any number of threads at the same time
+        - Find (x) returns the current root of x
+        - Union (x, y) joins two sets containing x and y, returns false if x and y were already in the same set
+        - SameSet (x, y) returns true iff x and y are in the same set
+
+    Input:
+        - n, number of sets
+        - seed, seed of the random priorities
+*/
+
+struct ConcurrentDisjointSet {
+    int n;
+    vector <atomic <int>> parent;
+    vector <int> priority;
+
+    ConcurrentDisjointSet (int n, unsigned seed = 1): n(n), parent(n), priority(n) {
+        for (int i = 0; i < n; i++) {
+            parent[i].store(i, memory_order_relaxed);
+            priority[i] = i;
+        }
+        shuffle(priority.begin(), priority.end(), mt19937(seed));
+    }
+
+    int Find (int x) {
+        while (true) {
+            int p = parent[x].load(memory_order_acquire);
+            if (p == x) {
+                return x;
+            }
+            int g = parent[p].load(memory_order_acquire);
+            if (p != g) {
+                parent[x].compare_exchange_weak(p, g, memory_order_release, memory_order_relaxed);
+            }
+            x = g;
+        }
+    }
+
+    bool Union (int x, int y) {
+        while (true) {
+            x = Find(x), y = Find(y);
+            if (x == y) {
+                return false;
+            }
+            if (priority[x] > priority[y]) {
+                swap(x, y);
+            }
+            int expected = x;
+            if (parent[x].compare_exchange_strong(expected, y, memory_order_acq_rel)) {
+                return true;
+            }
+        }
+    }
+
+    bool SameSet (int x, int y) {
+        while (true) {
+            x = Find(x), y = Find(y);
+            if (x == y) {
+                return true;
+            }
+            if (parent[x].load(memory_order_acquire) == x) {
+                return false;
+            }
+        }
+    }
+};
+
+/*
+    Implementation of disjoint-set data structure supporting Move and Delete of single elements,
+    with an aggregate of a commutative monoid kept per set
+
+    Running time:
+        - O(⍺(n)) amortized per Union(), Move(), Delete(), Find(), Size()
+        - Aggregate(): O(⍺(n)) if M has Inverse(), otherwise a set whose aggregate lost an element
+        is recomputed on its next query in O(size of the set)
+
+    Usage:
+        - every element lives in a slot of a flat forest, Move() and Delete() leave the old slot behind
+        as a dead node and give the element a fresh slot (the "shadow node" trick of UVA 11987),
+        dead slots are dropped by an O(n) compaction once they outnumber the elements
+        - live slots of a set form a circular doubly linked list, spliced in O(1) by Union()
+        - Union (x, y) joins the sets of x and y, Move (x, y) moves x to the set of y,
+        Delete (x) removes x from its set (x must not be used afterwards)
+        - Find (x) returns an id of the set containing x, Size (x) its number of elements,
+        Aggregate (x) the combination of the values of its elements
+        - M is a struct like:
+            struct Sum {
+                typedef long long T;
+                static T Identity () { return 0; }
+                static T Combine (const T& a, const T& b) { return a + b; }
+                static T Inverse (const T& a) { return -a; } // optional
+            };
+
+    Input:
+        - values, values[x] is the value of element x
+
+    Tested Problems:
+*/
+
+template <class M> struct AlmostDisjointSet {
+    typedef typename M::T T;
+    int n;
+    vector <int> slot, parent, rank, count, next, prev, owner;
+    vector <T> value, aggregate;
+    vector <bool> dirty;
+
+    template <class U> static auto HasInverse (int) -> decltype(U::Inverse(declval <T>()), true_type());
+    template <class U> static false_type HasInverse (...);
+    static const bool invertible = decltype(HasInverse <M>(0))::value;
+
+    AlmostDisjointSet (const vector <T>& values): n(values.size()), slot(n), value(values) {
+        for (int x = 0; x < n; ++x) {
+            slot[x] = NewSlot(x);
+        }
+    }
+
+    int NewSlot (int x) {
+        int s = parent.size();
+        parent.push_back(s), rank.push_back(0), count.push_back(1);
+        next.push_back(s), prev.push_back(s), owner.push_back(x);
+        aggregate.push_back(value[x]), dirty.push_back(false);
+        return s;
+    }
+
+    int Root (int s) {
+        while (parent[s] != s) {
+            s = parent[s] = parent[parent[s]];
+        }
+        return s;
+    }
+
+    int Find (int x) {
+        return Root(slot[x]);
+    }
+
+    int Size (int x) {
+        return count[Find(x)];
+    }
+
+    T Aggregate (int x) {
+        int r = Find(x);
+        if (dirty[r]) {
+            T ret = M::Identity();
+            int s = r;
+            do {
+                if (owner[s] != -1) {
+                    ret = M::Combine(ret, value[owner[s]]);
+                }
+                s = next[s];
+            } while (s != r);
+            aggregate[r] = ret, dirty[r] = false;
+        }
+        return aggregate[r];
+    }
+
+    // splices the circular list of b after a
+    void Splice (int a, int b) {
+        int an = next[a], bp = prev[b];
+        next[a] = b, prev[b] = a;
+        next[bp] = an, prev[an] = bp;
+    }
+
+    bool Union (int x, int y) {
+        int a = Find(x), b = Find(y);
+        if (a == b) {
+            return false;
+        }
+        if (rank[a] < rank[b]) {
+            swap(a, b);
+        }
+        parent[b] = a;
+        rank[a] = max(rank[a], rank[b] + 1);
+        count[a] += count[b];
+        aggregate[a] = M::Combine(aggregate[a], aggregate[b]);
+        dirty[a] = dirty[a] || dirty[b];
+        Splice(a, b);
+        return true;
+    }
+
+    // takes x out of its set, its slot stays in the forest as a dead node
+    void Detach (int x) {
+        int s = slot[x], r = Find(x);
+        count[r]--;
+        if (invertible) {
+            Subtract(aggregate[r], value[x]);
+        } else {
+            dirty[r] = true;
+        }
+        owner[s] = -1;
+        // the root has to stay in the list, so only non-root slots are unlinked
+        if (s != r) {
+            next[prev[s]] = next[s], prev[next[s]] = prev[s];
+            next[s] = prev[s] = s;
+        }
+    }
+
+    template <class U = M> typename enable_if <decltype(HasInverse <U>(0))::value>::type Subtract (T& a, const T& v) {
+        a = M::Combine(a, U::Inverse(v));
+    }
+
+    template <class U = M> typename enable_if <!decltype(HasInverse <U>(0))::value>::type Subtract (T&, const T&) {}
+
+    bool Move (int x, int y) {
+        int a = Find(x), b = Find(y);
+        if (a == b) {
+            return false;
+        }
+        Detach(x);
+        int s = NewSlot(x);
+        slot[x] = s, parent[s] = b;
+        count[b]++;
+        aggregate[b] = M::Combine(aggregate[b], value[x]);
+        Splice(b, s);
+        Compact();
+        return true;
+    }
+
+    void Delete (int x) {
+        Detach(x);
+        slot[x] = -1;
+        Compact();
+    }
+
+    // rebuilds the forest with one slot per remaining element once dead slots outnumber them
+    void Compact () {
+        if (int(parent.size()) <= 2 * n + 16) {
+            return;
+        }
+        vector <int> root(n, -1), old = slot;
+        vector <int> rootOf(parent.size(), -1);
+        for (int x = 0; x < n; ++x) {
+            if (old[x] != -1) {
+                int r = Root(old[x]);
+                if (rootOf[r] == -1) {
+                    rootOf[r] = x;
+                }
+                root[x] = rootOf[r];
+            }
+        }
+        parent.clear(), rank.clear(), count.clear(), next.clear(), prev.clear();
+        owner.clear(), aggregate.clear(), dirty.clear();
+        for (int x = 0; x < n; ++x) {
+            slot[x] = NewSlot(x);
+            if (old[x] == -1) {
+                owner[x] = -1, count[x] = 0, aggregate[x] = M::Identity();
+            }
+        }
+        for (int x = 0; x < n; ++x) {
+            if (root[x] != -1 && root[x] != x) {
+                int r = root[x];
+                parent[x] = r, rank[r] = 1, count[r]++;
+                aggregate[r] = M::Combine(aggregate[r], value[x]);
+                Splice(r, x);
+            }
+        }
+        for (int x = 0; x < n; ++x) {
+            if (old[x] == -1) {
+                slot[x] = -1;
+            }
+        }
+    }
+};
+
+/*
+    Compile-time alphabets for the Tries, mapping an item to its child index
+
+    Usage:
+        - every alphabet has size, the number of children per node, and Index (c) which maps an item
+        to [0, size), items outside the alphabet map to -1 and must not be inserted
+        - character alphabets derive from TableAlphabet and only give a constexpr Map (c) for c in [0, 256),
+        Index (c) is then a single lookup in a 256-entry table built at compile time
+        - CustomAlphabet <'0', '1'> maps the listed characters to 0, 1, ... in order
+        - IntegerAlphabet <n> is the identity for items already in [0, n), like vector <int>
+*/
+
+template <class A, int n> struct TableAlphabet {
+    static const int size = n;
+
+    struct Table {
+        int16_t at[256];
+    };
+
+    static constexpr Table Build () {
+        Table t = {};
+        for (int c = 0; c < 256; ++c) {
+            t.at[c] = A::Map(c);
+        }
+        return t;
+    }
+
+    static constexpr Table table = Build();
+
+    template <class C> static int Index (C c) {
+        return table.at[(unsigned char) c];
+    }
+};
+
+struct LowercaseAlphabet : TableAlphabet <LowercaseAlphabet, 26> {
+    static constexpr int Map (int c) {
+        return 'a' <= c && c <= 'z' ? c - 'a' : -1;
+    }
+};
+
+struct UppercaseAlphabet : TableAlphabet <UppercaseAlphabet, 26> {
+    static constexpr int Map (int c) {
+        return 'A' <= c && c <= 'Z' ? c - 'A' : -1;
+    }
+};
+
+// [a-z] to [0, 26) and [A-Z] to [26, 52)
+struct MixedCaseAlphabet : TableAlphabet <MixedCaseAlphabet, 52> {
+    static constexpr int Map (int c) {
+        return 'a' <= c && c <= 'z' ? c - 'a' : 'A' <= c && c <= 'Z' ? c - 'A' + 26 : -1;
+    }
+};
+
+struct DigitAlphabet : TableAlphabet <DigitAlphabet, 10> {
+    static constexpr int Map (int c) {
+        return '0' <= c && c <= '9' ? c - '0' : -1;
+    }
+};
+
+// A, C, G, T in either case
+struct DNAAlphabet : TableAlphabet <DNAAlphabet, 4> {
+    static constexpr int Map (int c) {
+        return c == 'A' || c == 'a' ? 0 : c == 'C' || c == 'c' ? 1 : c == 'G' || c == 'g' ? 2 : c == 'T' || c == 't' ? 3 : -1;
+    }
+};
+
+struct ByteAlphabet : TableAlphabet <ByteAlphabet, 256> {
+    static constexpr int Map (int c) {
+        return c;
+    }
+};
+
+template <char... cs> struct CustomAlphabet : TableAlphabet <CustomAlphabet <cs...>, sizeof...(cs)> {
+    static constexpr int Map (int c) {
+        const char s[] = {cs...};
+        for (int i = 0; i < int(sizeof...(cs)); ++i) if ((unsigned char) s[i] == c) {
+                return i;
+            }
+        return -1;
+    }
+};
+
+template <int n> struct IntegerAlphabet {
+    static const int size = n;
+
+    template <class C> static int Index (C c) {
+        return int(c);
+    }
+};
+
 /*
     Implementation of dynamic Prefix Tree (Trie) data structure
 
     Usage:
-        - Initialize dynamicaly like: Trie <string, 26> *root = new Trie <string, 26> ()
+        - Initialize dynamicaly like: Trie <string> *root = new Trie <string> ()
         - Insert (word) inserts a iterable word (string, vector etc) into the Trie
         - Count (word) returns the total occurance of word and number of words having prefix word, respectively
+        - Erase (word) removes an occurance of word, nodes of dead subtrees go to a free list kept by the
+        root and are reused by its next Insert() calls, so a Trie with churn stays at constant memory,
+        ClearFreed () releases them early, otherwise they are deleted with the root
+        - Insert() and Erase() must be called on the root
         - If using pointer, don't forget to delete the Trie after each usage!
-            Trie <string, 26> *root = new Trie <string, 26> ();
+            Trie <string, MixedCaseAlphabet> *root = new Trie <string, MixedCaseAlphabet> ();
             ...
             delete root;
 
     Input:
         - T, an iterable class name like string, vector etc
-        - n, alphabet size
-        - value(), an function to convert item to alphabet index, like [a-z] to [0, 26) or [a-zA-Z] to [0, 52)
+        - A, alphabet mapping items to child indices, default is LowercaseAlphabet
 
     Tested Problems:
         - Codeforces: 455B
         - UVA: 760, 12837
 */
 
-template <class T, int n> struct Trie {
+template <class T, class A = LowercaseAlphabet> struct Trie {
+    static const int n = A::size;
     int words, prefixes;
-    Trie <T, n> **children;
+    Trie <T, A> **children;
+    // on the root, the first node of its free list, on a freed node, the next one
+    Trie <T, A> *freed;
 
-    Trie (): words(0), prefixes(0), children (NULL) {}
+    Trie (): words(0), prefixes(0), children (NULL), freed(NULL) {}
 
     int value (typename T::const_iterator it) {
-        // return *it; // for integers
-        return *it - 'a'; // for lowercase strings
-        // return *it - 'A'; // for uppercase strings
-        // return 'a' <= *it && *it <= 'z' ? *it - 'a' : *it - 'A' + 26; // for both lower and uppercase strings
-        // return *it - '0'; // for integer strings
+        return A::Index(*it);
+    }
+
+    // frees the nodes kept by the free list of this root
+    void ClearFreed () {
+        while (freed) {
+            Trie <T, A> *u = freed;
+            freed = u->freed;
+            u->freed = NULL;
+            delete u;
+        }
+    }
+
+    // takes a node from the free list of this root, freed nodes are reset and keep their children array
+    Trie <T, A> *Make () {
+        if (!freed) {
+            return new Trie <T, A> ();
+        }
+        Trie <T, A> *node = freed;
+        freed = node->freed;
+        node->freed = NULL;
+        return node;
+    }
+
+    // moves the subtree of node to the free list of this root
+    void Reclaim (Trie <T, A> *node) {
+        vector <Trie <T, A> *> st(1, node);
+        while (!st.empty()) {
+            Trie <T, A> *u = st.back();
+            st.pop_back();
+            u->words = u->prefixes = 0;
+            if (u->children) {
+                for (int i = 0; i < n; ++i) if (u->children[i]) {
+                        st.push_back(u->children[i]);
+                        u->children[i] = NULL;
+                    }
+            }
+            u->freed = freed;
+            freed = u;
+        }
     }
 
     void Insert (typename T::const_iterator it, typename T::const_iterator end, int val = 1) {
-        prefixes += val;
-        if (it != end) {
+        Trie <T, A> *u = this;
+        u->prefixes += val;
+        for (; it != end; ++it) {
             int i = value(it);
-            if (!children) {
-                children = new Trie <T, n> *[n] ();
+            if (!u->children) {
+                u->children = new Trie <T, A> *[n] ();
             }
-            if (!children[i]) {
-                children[i] = new Trie <T, n> ();
+            if (!u->children[i]) {
+                u->children[i] = Make();
             }
-            children[i]->Insert(++it, end, val);
-        } else {
-            words += val;
+            u = u->children[i];
+            u->prefixes += val;
         }
+        u->words += val;
     }
 
     void Insert (const T& word, int val = 1) {
         Insert(word.begin(), word.end(), val);
     }
 
+    /*
+        Removes val occurances of word, returns false (and changes nothing) if word occurs less than val times.
+        Subtrees left without any word are unlinked and their nodes are reused by later Insert() calls
+    */
+    bool Erase (const T& word, int val = 1) {
+        if (Count(word).x < val) {
+            return false;
+        }
+        Trie <T, A> *u = this;
+        prefixes -= val;
+        for (auto it = word.begin(); it != word.end(); ++it) {
+            int i = value(it);
+            Trie <T, A> *v = u->children[i];
+            if (v->prefixes == val) {
+                u->children[i] = NULL;
+                Reclaim(v);
+                return true;
+            }
+            v->prefixes -= val;
+            u = v;
+        }
+        u->words -= val;
+        return true;
+    }
+
     pair <int, int> Count (typename T::const_iterator it, typename T::const_iterator end) {
         if (it == end) {
             return make_pair (words, prefixes);
         } else {
             int i = value(it);
-            return children[i] ? children[i]->Count(++it, end) : make_pair(0, 0);
+            return children && children[i] ? children[i]->Count(++it, end) : make_pair(0, 0);
         }
     }
 
@@ -181,13 +660,16 @@ template <class T, int n> struct Trie {
 
     void Print (int tab = 0) {
         cout << "Words: " << words << ", Prefixes: " << prefixes << ", Childrens:" << endl;
-        for (int i = 0; i < n; ++i) if (children[i]) {
-                cout << setw(tab) << i << " -> ";
-                children[i]->Print(tab + 4);
-            }
+        if (children) {
+            for (int i = 0; i < n; ++i) if (children[i]) {
+                    cout << setw(tab) << i << " -> ";
+                    children[i]->Print(tab + 4);
+                }
+        }
     }
 
     ~Trie () {
+        ClearFreed();
         if (children) {
             for (int i = 0; i < n; ++i) if (children[i]) {
                     delete children[i];
@@ -198,103 +680,835 @@ template <class T, int n> struct Trie {
 };
 
 /*
-    Implementation of memory efficient static Prefix Tree (Trie) data structure
+    Implementation of arena-backed Prefix Tree (Trie) with 32-bit child indices
+
+    Running time:
+        O(|word|) per Insert() and Count() with dense children, O(|word| * degree) with sparse ones
+        Reset() is O(n), independent of the number of nodes
 
     Usage:
-        - In this version, an array of StaticTrie pointers should be declared. Example:
-            StaticTrie <string, 2> *root = new StaticTrie <string, 2> [2 * 1024 * 1024] ();
-        - Initialize the Trie every time by calling Init() from root node: root->Init(new int())
+        - all nodes live in contiguous vectors and refer to each other by index, node 0 is the root
+        and index 0 also means "no child"
+        - dense = true stores A::size child indices per node (small alphabets), dense = false stores children
+        as sorted first-child/next-sibling lists (large alphabets like raw bytes)
         - Insert (word) inserts a iterable word (string, vector etc) into the Trie
         - Count (word) returns the total occurance of word and number of words having prefix word, respectively
+        - Reset () empties the Trie but keeps the memory, so it can be reused for the next test case
 
     Input:
         - T, an iterable class name like string, vector etc
-        - n, alphabet size
-        - value(), an function to convert item to alphabet index, like [a-z] to [0, 26) or [a-zA-Z] to [0, 52)
+        - A, alphabet mapping items to child indices, default is LowercaseAlphabet
+        - dense, layout of children, default is dense for alphabets of at most 32 items
 
     Tested Problems:
-        - Live Archive: 4682
-        - Codeforces: 455B
-        - UVA: 760, 11512, 12837
 */
 
-template <class T, int n> struct StaticTrie {
-    int words, prefixes;
-    StaticTrie <T, n> **children;
-    int index, *tail;
-
-    StaticTrie (): words(0), prefixes(0), children(NULL) {}
+template <class T, class A = LowercaseAlphabet, bool dense = (A::size <= 32)> struct ArenaTrie {
+    static const int n = A::size;
+    int size;
+    vector <int> words, prefixes;
+    vector <uint32_t> child, sibling;
+    vector <int> symbol;
 
-    void Init (int *tail) {
-        this->tail = tail;
-        index = *tail;
-        words = 0, prefixes = 0;
-        if (children) {
-            delete[] children;
-            children = NULL;
-        }
+    ArenaTrie (): size(0) {
+        Reset();
     }
 
     int value (typename T::const_iterator it) {
-        // return *it; // for integers
-        // return *it - 'a'; // for lowercase strings
-        // return *it - 'A'; // for uppercase strings
-        // return 'a' <= *it && *it <= 'z' ? *it - 'a' : *it - 'A' + 26; // for both lower and uppercase strings
-        return *it - '0'; // for integer strings
+        return A::Index(*it);
     }
 
-    void Insert (typename T::const_iterator it, typename T::const_iterator end, int val = 1) {
-        prefixes += val;
-        if (it != end) {
-            int i = value(it);
-            if (!children) {
-                children = new StaticTrie <T, n> *[n] ();
-            }
-            if (!children[i]) {
-                (*tail)++;
-                children[i] = this + (*tail - index);
-                children[i]->Init(tail);
+    void Reset () {
+        size = 0;
+        NewNode();
+    }
+
+    void Reserve (int nodes) {
+        words.reserve(nodes), prefixes.reserve(nodes), child.reserve(dense ? size_t(nodes) * n : nodes);
+        if (!dense) {
+            sibling.reserve(nodes), symbol.reserve(nodes);
+        }
+    }
+
+    uint32_t NewNode (int c = -1) {
+        uint32_t u = size++;
+        if (words.size() < size_t(size)) {
+            words.push_back(0), prefixes.push_back(0);
+            child.resize(dense ? size_t(size) * n : size);
+            if (!dense) {
+                sibling.push_back(0), symbol.push_back(0);
             }
-            children[i]->Insert(++it, end, val);
+        }
+        words[u] = prefixes[u] = 0;
+        if (dense) {
+            fill(child.begin() + size_t(u) * n, child.begin() + size_t(u + 1) * n, 0);
         } else {
-            words += val;
+            child[u] = sibling[u] = 0, symbol[u] = c;
         }
+        return u;
     }
 
-    void Insert (const T&& word, int val = 1) {
-        Insert(word.begin(), word.end(), val);
+    // in sparse mode child[u] is the first child and sibling[v] the next one, ordered by symbol
+    uint32_t Child (uint32_t u, int c) const {
+        if (dense) {
+            return child[size_t(u) * n + c];
+        }
+        uint32_t v = child[u];
+        while (v && symbol[v] < c) {
+            v = sibling[v];
+        }
+        return v && symbol[v] == c ? v : 0;
     }
 
-    pair <int, int> Count (typename T::const_iterator it, typename T::const_iterator end) {
-        if (it == end) {
-            return make_pair (words, prefixes);
+    uint32_t AddChild (uint32_t u, int c) {
+        if (dense) {
+            uint32_t v = child[size_t(u) * n + c];
+            if (!v) {
+                v = NewNode();
+                child[size_t(u) * n + c] = v;
+            }
+            return v;
+        }
+        uint32_t prev = 0, v = child[u];
+        while (v && symbol[v] < c) {
+            prev = v, v = sibling[v];
+        }
+        if (v && symbol[v] == c) {
+            return v;
+        }
+        uint32_t w = NewNode(c);
+        sibling[w] = v;
+        if (prev) {
+            sibling[prev] = w;
         } else {
-            int i = value(it);
-            return children && children[i] ? children[i]->Count(++it, end) : make_pair(0, 0);
+            child[u] = w;
         }
+        return w;
     }
 
-    pair <int, int> Count (const T& word) {
-        return Count(word.begin(), word.end());
+    void Insert (typename T::const_iterator it, typename T::const_iterator end, int val = 1) {
+        uint32_t u = 0;
+        prefixes[u] += val;
+        for (; it != end; ++it) {
+            u = AddChild(u, value(it));
+            prefixes[u] += val;
+        }
+        words[u] += val;
     }
 
-    void Print (int tab = 0) {
-        cout << "Words: " << words << ", Prefixes: " << prefixes << ", Childrens:" << endl;
-        if (children) {
-            for (int i = 0; i < n; ++i) if (children[i]) {
-                    cout << setw(tab) << i << " -> ";
-                    children[i]->Print(tab + 4);
-                }
-        }
+    void Insert (const T& word, int val = 1) {
+        Insert(word.begin(), word.end(), val);
     }
 
-    ~StaticTrie () {
-        if (children) {
-            delete[] children;
+    pair <int, int> Count (typename T::const_iterator it, typename T::const_iterator end) {
+        uint32_t u = 0;
+        for (; it != end; ++it) {
+            if (!(u = Child(u, value(it)))) {
+                return make_pair(0, 0);
+            }
         }
+        return make_pair(words[u], prefixes[u]);
     }
-};
 
+    pair <int, int> Count (const T& word) {
+        return Count(word.begin(), word.end());
+    }
+};
+
+/*
+    Implementation of memory efficient static Prefix Tree (Trie) data structure
+
+    Usage:
+        - The Trie owns a growable arena of nodes, every node stores its child table inline, children
+        are referred to by 32-bit index and index 0 (the root) means "no child"
+            StaticTrie <string, CustomAlphabet <'0', '1'>> *root = new StaticTrie <string, CustomAlphabet <'0', '1'>> ();
+        - Reset the Trie before every test case by calling Init(), it is O(1): it only bumps the
+        generation, every node is lazily cleared the first time it is touched in a new generation
+        - Reserve (nodes) preallocates the arena
+        - Insert (word) inserts a iterable word (string, vector etc) into the Trie
+        - Count (word) returns the total occurance of word and number of words having prefix word, respectively
+        - Child (u, c) returns the child of node u for item c (0 if none) for walking the Trie by hand,
+        Node (u) gives its words and prefixes
+
+    Input:
+        - T, an iterable class name like string, vector etc
+        - A, alphabet mapping items to child indices, default is DigitAlphabet
+
+    Tested Problems:
+        - Live Archive: 4682
+        - Codeforces: 455B
+        - UVA: 760, 11512, 12837
+*/
+
+template <class T, class A = DigitAlphabet> struct StaticTrie {
+    static const int n = A::size;
+
+    struct Cell {
+        int words, prefixes;
+        uint32_t stamp;
+        uint32_t children[n];
+    };
+
+    vector <Cell> arena;
+    uint32_t size, generation;
+
+    StaticTrie (): arena(1), size(1), generation(1) {
+        arena[0].stamp = 0;
+    }
+
+    void Init () {
+        size = 1;
+        if (++generation == 0) {
+            for (auto& c : arena) {
+                c.stamp = 0;
+            }
+            generation = 1;
+        }
+    }
+
+    void Reserve (int nodes) {
+        arena.reserve(nodes);
+    }
+
+    int value (typename T::const_iterator it) {
+        return A::Index(*it);
+    }
+
+    Cell& Node (uint32_t u) {
+        Cell& c = arena[u];
+        if (c.stamp != generation) {
+            c.words = c.prefixes = 0;
+            c.stamp = generation;
+            memset(c.children, 0, sizeof(c.children));
+        }
+        return c;
+    }
+
+    uint32_t Child (uint32_t u, int i) {
+        return Node(u).children[i];
+    }
+
+    uint32_t NewNode () {
+        if (size == arena.size()) {
+            arena.push_back(Cell());
+            arena.back().stamp = 0;
+        }
+        Node(size);
+        return size++;
+    }
+
+    void Insert (typename T::const_iterator it, typename T::const_iterator end, int val = 1) {
+        uint32_t u = 0;
+        Node(u).prefixes += val;
+        for (; it != end; ++it) {
+            int i = value(it);
+            uint32_t v = Node(u).children[i];
+            if (!v) {
+                v = NewNode();
+                arena[u].children[i] = v;
+            }
+            Node(v).prefixes += val;
+            u = v;
+        }
+        Node(u).words += val;
+    }
+
+    void Insert (const T& word, int val = 1) {
+        Insert(word.begin(), word.end(), val);
+    }
+
+    pair <int, int> Count (typename T::const_iterator it, typename T::const_iterator end) {
+        uint32_t u = 0;
+        for (; it != end; ++it) {
+            if (!(u = Child(u, value(it)))) {
+                return make_pair(0, 0);
+            }
+        }
+        return make_pair(Node(u).words, Node(u).prefixes);
+    }
+
+    pair <int, int> Count (const T& word) {
+        return Count(word.begin(), word.end());
+    }
+
+    void Print (uint32_t u = 0, int tab = 0) {
+        cout << "Words: " << Node(u).words << ", Prefixes: " << Node(u).prefixes << ", Childrens:" << endl;
+        for (int i = 0; i < n; ++i) if (Child(u, i)) {
+                cout << setw(tab) << i << " -> ";
+                Print(Child(u, i), tab + 4);
+            }
+    }
+};
+
+
+/*
+    Implementation of binary Trie keyed directly on fixed-width unsigned integers
+
+    Running time:
+        O(bits) per operation
+
+    Usage:
+        - Insert (x) inserts x, Erase (x) removes one occurance of x (returns false if there is none),
+        Count (x) returns the number of occurances of x, Size () the number of elements
+        - MaxXor (x), MinXor (x) return the maximum and minimum of x ^ y over all elements y,
+        the Trie must not be empty
+        - MaxXor (xs, k, out), MinXor (xs, k, out) answer k queries from an array into out
+        - nodes are never freed by Erase(), a node is alive iff its count is positive
+
+    Input:
+        - U, unsigned integer type of the keys
+        - bits, number of low bits of the keys that are used
+
+    Tested Problems:
+*/
+
+template <class U = uint32_t, int bits = 8 * sizeof(U)> struct BinaryTrie {
+    vector <uint32_t> child;
+    vector <int> count;
+
+    BinaryTrie () {
+        Clear();
+    }
+
+    void Clear () {
+        child.assign(2, 0), count.assign(1, 0);
+    }
+
+    void Insert (U x, int val = 1) {
+        uint32_t u = 0;
+        count[u] += val;
+        for (int i = bits - 1; i >= 0; --i) {
+            int b = (x >> i) & 1;
+            if (!child[2 * u + b]) {
+                child[2 * u + b] = count.size();
+                count.push_back(0), child.push_back(0), child.push_back(0);
+            }
+            u = child[2 * u + b];
+            count[u] += val;
+        }
+    }
+
+    int Count (U x) const {
+        uint32_t u = 0;
+        for (int i = bits - 1; i >= 0; --i) {
+            u = child[2 * u + ((x >> i) & 1)];
+            if (!u || count[u] <= 0) {
+                return 0;
+            }
+        }
+        return count[u];
+    }
+
+    bool Erase (U x, int val = 1) {
+        if (Count(x) < val) {
+            return false;
+        }
+        Insert(x, -val);
+        return true;
+    }
+
+    int Size () const {
+        return count[0];
+    }
+
+    // walks towards the branch that agrees with x ^ want at every bit, if it is alive
+    U Walk (U x, U want) const {
+        uint32_t u = 0;
+        U ret = 0;
+        for (int i = bits - 1; i >= 0; --i) {
+            int b = ((x ^ want) >> i) & 1;
+            uint32_t v = child[2 * u + b];
+            if (!v || count[v] <= 0) {
+                b ^= 1, v = child[2 * u + b];
+            }
+            ret |= U(b) << i;
+            u = v;
+        }
+        return x ^ ret;
+    }
+
+    U MaxXor (U x) const {
+        return Walk(x, ~U(0));
+    }
+
+    U MinXor (U x) const {
+        return Walk(x, 0);
+    }
+
+    void MaxXor (const U *xs, size_t k, U *out) const {
+        for (size_t i = 0; i < k; ++i) {
+            out[i] = MaxXor(xs[i]);
+        }
+    }
+
+    void MinXor (const U *xs, size_t k, U *out) const {
+        for (size_t i = 0; i < k; ++i) {
+            out[i] = MinXor(xs[i]);
+        }
+    }
+};
+
+/*
+    Implementation of persistent (path-copying) binary Trie with per-node counts
+
+    Running time:
+        O(bits) time and O(bits) new nodes per Insert(), O(bits) per query
+
+    Usage:
+        - version 0 is the empty Trie, Insert (x, version) creates a new version containing x and
+        returns its index (default is on top of the latest version)
+        - Append (a) inserts every element of a in order, so that version l holds a[0..l-1] (when
+        called on a fresh Trie)
+        - MaxXor (l, r, x), MinXor (l, r, x) return the maximum and minimum of x ^ y over the elements
+        inserted between version l and version r, i.e. over a[l..r-1] after Append (a).
+        Version r must be derived from version l and contain at least one more element
+        - Count (l, r, x) returns the number of occurances of x between version l and version r
+
+    Input:
+        - U, unsigned integer type of the keys
+        - bits, number of low bits of the keys that are used
+
+    Tested Problems:
+*/
+
+template <class U = uint32_t, int bits = 8 * sizeof(U)> struct PersistentBinaryTrie {
+    vector <uint32_t> child, roots;
+    vector <int> count;
+
+    // node 0 is an empty sentinel whose children are itself
+    PersistentBinaryTrie (): child(2, 0), roots(1, 0), count(1, 0) {}
+
+    void Reserve (size_t elements) {
+        child.reserve(2 * (elements * (bits + 1) + 1)), count.reserve(elements * (bits + 1) + 1);
+        roots.reserve(elements + 1);
+    }
+
+    uint32_t Copy (uint32_t u) {
+        uint32_t v = count.size();
+        count.push_back(count[u]);
+        child.push_back(child[2 * u]), child.push_back(child[2 * u + 1]);
+        return v;
+    }
+
+    int Insert (U x, int version = -1) {
+        uint32_t old = roots[version == -1 ? roots.size() - 1 : version];
+        uint32_t root = Copy(old), u = root;
+        count[u]++;
+        for (int i = bits - 1; i >= 0; --i) {
+            int b = (x >> i) & 1;
+            uint32_t v = Copy(child[2 * u + b]);
+            count[v]++;
+            child[2 * u + b] = v;
+            u = v;
+        }
+        roots.push_back(root);
+        return roots.size() - 1;
+    }
+
+    void Append (const vector <U>& a) {
+        Reserve(roots.size() + a.size());
+        for (auto& x : a) {
+            Insert(x);
+        }
+    }
+
+    int Count (int l, int r, U x) const {
+        uint32_t a = roots[l], b = roots[r];
+        for (int i = bits - 1; i >= 0; --i) {
+            int bit = (x >> i) & 1;
+            a = child[2 * a + bit], b = child[2 * b + bit];
+        }
+        return count[b] - count[a];
+    }
+
+    // walks towards the branch that agrees with x ^ want at every bit, if it has elements in the range
+    U Walk (int l, int r, U x, U want) const {
+        uint32_t a = roots[l], b = roots[r];
+        U ret = 0;
+        for (int i = bits - 1; i >= 0; --i) {
+            int bit = ((x ^ want) >> i) & 1;
+            if (count[child[2 * b + bit]] - count[child[2 * a + bit]] <= 0) {
+                bit ^= 1;
+            }
+            ret |= U(bit) << i;
+            a = child[2 * a + bit], b = child[2 * b + bit];
+        }
+        return x ^ ret;
+    }
+
+    U MaxXor (int l, int r, U x) const {
+        return Walk(l, r, x, ~U(0));
+    }
+
+    U MinXor (int l, int r, U x) const {
+        return Walk(l, r, x, 0);
+    }
+};
+
+/*
+    Implementation of bottom-up (non-recursive) segment tree over an associative operation
+
+    Running time:
+        O(n) to build, O(log(n)) per Update() and Query()
+
+    Usage:
+        - SegmentTree <int> for sums, SegmentTree <int, Maximum <int>> (a, -inf) for maximums
+        - Update (i, v) sets a[i] = v
+        - Query (l, r) returns F(a[l], a[l + 1], ..., a[r - 1]), or identity if l >= r
+
+    Input:
+        - T, type of elements
+        - F, associative operation, default is std::plus
+        - a (or n), initial elements (or number of elements, all set to identity)
+        - identity, identity element of F
+
+    Tested Problems:
+*/
+
+template <class T> struct Maximum {
+    T operator () (const T& a, const T& b) const {
+        return max(a, b);
+    }
+};
+
+template <class T> struct Minimum {
+    T operator () (const T& a, const T& b) const {
+        return min(a, b);
+    }
+};
+
+template <class T, class F = plus<T>> struct SegmentTree {
+    int n;
+    T identity;
+    vector <T> t;
+    F f;
+
+    SegmentTree (int n, T identity = T()): n(n), identity(identity), t(2 * n, identity) {}
+
+    SegmentTree (const vector <T>& a, T identity = T()): n(a.size()), identity(identity), t(2 * n, identity) {
+        copy(a.begin(), a.end(), t.begin() + n);
+        for (int i = n - 1; i > 0; --i) {
+            t[i] = f(t[2 * i], t[2 * i + 1]);
+        }
+    }
+
+    void Update (int i, T v) {
+        for (t[i += n] = v; i > 1; i >>= 1) {
+            t[i >> 1] = f(t[i & ~1], t[i | 1]);
+        }
+    }
+
+    T Query (int l, int r) const {
+        T left = identity, right = identity;
+        for (l += n, r += n; l < r; l >>= 1, r >>= 1) {
+            if (l & 1) {
+                left = f(left, t[l++]);
+            }
+            if (r & 1) {
+                right = f(t[--r], right);
+            }
+        }
+        return f(left, right);
+    }
+};
+
+/*
+    Implementation of Fenwick tree (Binary Indexed Tree)
+
+    Running time:
+        O(log(n)) per operation
+
+    Usage:
+        - FenwickTree: Add (i, v) does a[i] += v, Sum (r) returns a[0] + ... + a[r - 1], Sum (l, r) sums [l, r)
+        - RangeFenwickTree: Add (l, r, v) adds v to every a[i] for i in [l, r), Sum (l, r) sums [l, r)
+
+    Input:
+        - n, number of elements, all initially 0
+
+    Tested Problems:
+*/
+
+template <class T> struct FenwickTree {
+    int n;
+    vector <T> t;
+
+    FenwickTree (int n): n(n), t(n + 1, T(0)) {}
+
+    void Add (int i, T v) {
+        for (++i; i <= n; i += i & -i) {
+            t[i] += v;
+        }
+    }
+
+    T Sum (int r) const {
+        T ret = T(0);
+        for (; r > 0; r -= r & -r) {
+            ret += t[r];
+        }
+        return ret;
+    }
+
+    T Sum (int l, int r) const {
+        return Sum(r) - Sum(l);
+    }
+};
+
+template <class T> struct RangeFenwickTree {
+    FenwickTree <T> B, C;
+
+    RangeFenwickTree (int n): B(n + 1), C(n + 1) {}
+
+    // prefix sum of [0, r) is B(r) * r - C(r)
+    void Add (int l, int r, T v) {
+        B.Add(l, v), B.Add(r, -v);
+        C.Add(l, v * T(l)), C.Add(r, -v * T(r));
+    }
+
+    T Sum (int r) const {
+        return B.Sum(r) * T(r) - C.Sum(r);
+    }
+
+    T Sum (int l, int r) const {
+        return Sum(r) - Sum(l);
+    }
+};
+
+/*
+    Implementation of range minimum query structures returning the position of the minimum
+
+    Running time:
+        - SparseTableRMQ: O(n log(n)) time and memory to build, O(1) per query
+        - BlockRMQ: O(n) time and memory to build, O(1) per query. Positions are grouped in blocks
+        of 32, a bitmask of the monotone stack inside each block answers in-block queries with a
+        single ctz, and a sparse table over block minima answers the rest
+
+    Usage:
+        - Build (a), then Query (l, r) returns the leftmost i in [l, r] minimizing a[i]
+
+    Input:
+        - T, type of elements
+        - a, vector of elements
+
+    Tested Problems:
+*/
+
+template <class T> struct SparseTableRMQ {
+    int n, levels;
+    vector <T> a;
+    vector <int> table;
+
+    int Better (int i, int j) const {
+        return a[j] < a[i] ? j : i;
+    }
+
+    void Build (const vector <T>& a) {
+        this->a = a, n = a.size();
+        levels = 1;
+        while ((1 << levels) <= n) {
+            levels++;
+        }
+        table.assign(levels * n, 0);
+        for (int i = 0; i < n; ++i) {
+            table[i] = i;
+        }
+        for (int k = 1; k < levels; ++k) {
+            int *cur = &table[k * n], *prev = &table[(k - 1) * n];
+            for (int i = 0; i + (1 << k) <= n; ++i) {
+                cur[i] = Better(prev[i], prev[i + (1 << (k - 1))]);
+            }
+        }
+    }
+
+    int Query (int l, int r) const {
+        int k = 31 - __builtin_clz(r - l + 1);
+        return Better(table[k * n + l], table[k * n + r - (1 << k) + 1]);
+    }
+};
+
+template <class T> struct BlockRMQ {
+    int n;
+    vector <T> a;
+    vector <uint32_t> mask;
+    SparseTableRMQ <T> blocks;
+    vector <int> blockMin;
+
+    int Better (int i, int j) const {
+        return a[j] < a[i] ? j : i;
+    }
+
+    void Build (const vector <T>& a) {
+        this->a = a, n = a.size();
+        mask.assign(n, 0);
+        blockMin.clear();
+        vector <T> minima;
+        for (int b = 0; b < n; b += 32) {
+            uint32_t cur = 0;
+            for (int i = b; i < min(n, b + 32); ++i) {
+                while (cur && a[b + 31 - __builtin_clz(cur)] > a[i]) {
+                    cur ^= 1u << (31 - __builtin_clz(cur));
+                }
+                cur |= 1u << (i - b);
+                mask[i] = cur;
+            }
+            blockMin.push_back(b + __builtin_ctz(cur));
+            minima.push_back(a[blockMin.back()]);
+        }
+        blocks.Build(minima);
+    }
+
+    // l and r in the same block
+    int InBlock (int l, int r) const {
+        int b = l & ~31;
+        return b + __builtin_ctz(mask[r] & (~0u << (l - b)));
+    }
+
+    int Query (int l, int r) const {
+        int bl = l >> 5, br = r >> 5;
+        if (bl == br) {
+            return InBlock(l, r);
+        }
+        int ret = InBlock(l, bl * 32 + 31);
+        if (bl + 1 < br) {
+            ret = Better(ret, blockMin[blocks.Query(bl + 1, br - 1)]);
+        }
+        return Better(ret, InBlock(br * 32, r));
+    }
+};
+
+/*
+    Implementation of Lowest Common Ancestor by Euler tour + range minimum query
+
+    Running time:
+        - Build(): O(|V| log|V|) with SparseTableRMQ, O(|V|) with BlockRMQ
+        - Query(): O(1)
+        - Offline(): O((|V| + |Q|) ⍺(|V|)), Tarjan's offline algorithm, needs no Build()
+
+    Usage:
+        - LowestCommonAncestor <SparseTableRMQ <int>> for speed, LowestCommonAncestor <BlockRMQ <int>>
+        for linear memory
+        - add edges by AddEdge(), call Build(root), then Query (u, v) returns the LCA of u and v
+        - Query (queries, answers) answers a batch of queries
+        - Offline (queries, answers, root) answers a batch of queries without building the Euler tour
+        - everything is iterative, deep trees are safe
+
+    Input:
+        - n, number of nodes
+        - graph, a tree constructed using AddEdge()
+
+    Output:
+        - depth, depth[v] is the depth of v from root
+        - parent, parent[v] is the parent of v (-1 for root)
+
+    Tested Problems:
+*/
+
+template <class RMQ = SparseTableRMQ <int>> struct LowestCommonAncestor {
+    int n;
+    vector <vector <int>> adj;
+    vector <int> depth, parent, first, euler;
+    RMQ rmq;
+
+    LowestCommonAncestor (int n): n(n), adj(n) {}
+
+    void AddEdge (int a, int b) {
+        adj[a].push_back(b);
+        adj[b].push_back(a);
+    }
+
+    // iterative DFS, calls enter(u) on the first visit and leave(u) after its subtree
+    template <class Enter, class Leave> void Walk (int root, Enter enter, Leave leave) {
+        depth.assign(n, 0), parent.assign(n, -1);
+        vector <int> st(1, root), it(n, 0);
+        enter(root);
+        while (!st.empty()) {
+            int u = st.back();
+            if (it[u] < int(adj[u].size())) {
+                int v = adj[u][it[u]++];
+                if (v != parent[u]) {
+                    parent[v] = u, depth[v] = depth[u] + 1;
+                    st.push_back(v);
+                    enter(v);
+                }
+            } else {
+                st.pop_back();
+                leave(u);
+            }
+        }
+    }
+
+    void Build (int root = 0) {
+        first.assign(n, -1), euler.clear();
+        euler.reserve(2 * n);
+        vector <int> keys;
+        keys.reserve(2 * n);
+        Walk(root, [&](int u) {
+            first[u] = euler.size();
+            euler.push_back(u), keys.push_back(depth[u]);
+        }, [&](int u) {
+            if (parent[u] != -1) {
+                euler.push_back(parent[u]), keys.push_back(depth[parent[u]]);
+            }
+        });
+        rmq.Build(keys);
+    }
+
+    int Query (int u, int v) const {
+        int l = first[u], r = first[v];
+        if (l > r) {
+            swap(l, r);
+        }
+        return euler[rmq.Query(l, r)];
+    }
+
+    void Query (const vector <pair <int, int>>& queries, vector <int>& answers) const {
+        answers.resize(queries.size());
+        for (size_t i = 0; i < queries.size(); ++i) {
+            answers[i] = Query(queries[i].x, queries[i].y);
+        }
+    }
+
+    void Offline (const vector <pair <int, int>>& queries, vector <int>& answers, int root = 0) {
+        int q = queries.size();
+        vector <int> head(n + 1, 0), other(2 * q), id(2 * q);
+        for (auto& p : queries) {
+            head[p.x + 1]++, head[p.y + 1]++;
+        }
+        for (int u = 0; u < n; ++u) {
+            head[u + 1] += head[u];
+        }
+        vector <int> fill(head.begin(), head.end() - 1);
+        for (int i = 0; i < q; ++i) {
+            int a = queries[i].x, b = queries[i].y;
+            other[fill[a]] = b, id[fill[a]++] = i;
+            other[fill[b]] = a, id[fill[b]++] = i;
+        }
+
+        vector <int> up(n), ancestor(n);
+        vector <bool> done(n, false);
+        auto find = [&](int x) {
+            while (up[x] != x) {
+                x = up[x] = up[up[x]];
+            }
+            return x;
+        };
+        answers.assign(q, -1);
+        Walk(root, [&](int u) {
+            up[u] = u, ancestor[u] = u;
+        }, [&](int u) {
+            done[u] = true;
+            for (int i = head[u]; i < head[u + 1]; ++i) {
+                if (done[other[i]]) {
+                    answers[id[i]] = ancestor[find(other[i])];
+                }
+            }
+            if (parent[u] != -1) {
+                int p = find(parent[u]);
+                up[find(u)] = p;
+                ancestor[p] = parent[u];
+            }
+        });
+    }
+};
 
 template <class T, T I = T(0)> struct Matrix {
     int n, m;
@@ -49,6 +49,114 @@ struct TopologicalSort {
     }
 };
 
+/*
+    Implementation of Pearce-Kelly dynamic topological order maintenance
+
+    Running time:
+        O(|δ| log|δ|) per AddEdge, where δ is the set of nodes whose position lies between
+        the endpoints of the new edge and which are reachable from/to them
+
+    Usage:
+        - add edges by AddEdge(), the order is repaired after every insertion
+        - AddEdge(a, b) returns false (and leaves the graph unchanged) iff the edge would create a cycle
+
+    Input:
+        - n, number of nodes
+        - graph, constructed using AddEdge()
+
+    Output:
+        - order, order[i] is the node at position i, every edge a -> b has pos[a] < pos[b]
+        - pos, pos[v] is the position of v in order
+
+    Tested Problems:
+*/
+
+struct DynamicTopologicalSort {
+    int n;
+    vector <vector <int>> adj, radj;
+    vector <int> order, pos;
+    vector <bool> visited;
+    vector <int> forward, backward, st;
+
+    DynamicTopologicalSort (int n): n(n), adj(n), radj(n), order(n), pos(n), visited(n, false) {
+        for (int i = 0; i < n; ++i) {
+            order[i] = pos[i] = i;
+        }
+    }
+
+    // collects nodes reachable from s (along g) with position strictly inside the bound,
+    // returns false if node target is reached
+    bool Collect (int s, const vector <vector <int>>& g, int bound, bool down, int target, vector <int>& out) {
+        out.clear();
+        st.assign(1, s);
+        visited[s] = true;
+        while (!st.empty()) {
+            int u = st.back();
+            st.pop_back();
+            out.push_back(u);
+            for (auto& v : g[u]) {
+                if (v == target) {
+                    return false;
+                }
+                if (!visited[v] && (down ? pos[v] < bound : pos[v] > bound)) {
+                    visited[v] = true;
+                    st.push_back(v);
+                }
+            }
+        }
+        return true;
+    }
+
+    bool AddEdge (int a, int b) {
+        if (a == b) {
+            return false;
+        }
+        int lb = pos[b], ub = pos[a];
+        if (lb < ub) {
+            bool acyclic = Collect(b, adj, ub, true, a, forward);
+            for (auto& v : forward) {
+                visited[v] = false;
+            }
+            for (auto& v : st) {
+                visited[v] = false;
+            }
+            if (!acyclic) {
+                return false;
+            }
+            Collect(a, radj, lb, false, -1, backward);
+            for (auto& v : backward) {
+                visited[v] = false;
+            }
+            Reorder();
+        }
+        adj[a].push_back(b);
+        radj[b].push_back(a);
+        return true;
+    }
+
+    // places all of backward before all of forward, reusing their old positions
+    void Reorder () {
+        auto byPos = [&](int u, int v) {
+            return pos[u] < pos[v];
+        };
+        sort(forward.begin(), forward.end(), byPos);
+        sort(backward.begin(), backward.end(), byPos);
+
+        vector <int> slots;
+        merge(backward.begin(), backward.end(), forward.begin(), forward.end(), back_inserter(slots), byPos);
+        for (auto& v : slots) {
+            v = pos[v];
+        }
+        int i = 0;
+        for (auto& v : backward) {
+            order[slots[i]] = v, pos[v] = slots[i++];
+        }
+        for (auto& v : forward) {
+            order[slots[i]] = v, pos[v] = slots[i++];
+        }
+    }
+};
+
 /*
     Implementation of Tarjan's strongly connected components algorithm.
 
@@ -151,6 +259,368 @@ struct StronglyConnectedComponents {
     }
 };
 
+/*
+    Compact binary graph format (CSR) with a writer and a zero-copy mmap loader
+
+    File layout (little endian, every section 8-byte aligned):
+        - header, {magic "CSRG", version, n, m, weight size in bytes (0 if unweighted)}
+        - offsets, n + 1 uint64, edges of u are [offsets[u], offsets[u + 1])
+        - targets, m uint32
+        - weights, m values of type W (only if weighted)
+
+    Running time:
+        - Build(): O(|V| + |E|)
+        - Load(): O(|V|) to validate the offsets, the targets and weights are faulted in lazily by the kernel
+
+    Usage:
+        - requires <sys/mman.h>, <sys/stat.h>, <fcntl.h>, <unistd.h>
+        - add edges by AddEdge() and call Build(), or Load(path) a file written by Write(path)
+        - Build() merges the edges added since the last Build() into the adjacency, Flush() does it
+        only if there are such edges (or nothing was built yet)
+        - Begin(u), End(u) and Weight(i) give direct access to the adjacency of u, TwoSat, BellmanFord::SPFA
+        and DominatorTree use it as their adjacency
+        - ForEachEdge(f) calls f(u, v, w) for every edge, to copy the graph into engines that keep
+        their own adjacency lists:
+            G.ForEachEdge([&](int u, int v, int w) { D.addEdge(u, v, w); });
+        - Load() checks the header, the file size and the offsets, but not every target, so only
+        load files from a trusted writer
+
+    Input:
+        - n, number of nodes
+        - weighted, true iff edges carry a weight of type W
+
+    Output:
+        - offsets, targets, weights, pointing either to owned memory or into the mapped file
+
+    Tested Problems:
+*/
+
+template <class W = int> struct CSRGraph {
+    struct Header {
+        char magic[4];
+        uint32_t version;
+        uint64_t n, m;
+        uint64_t weightSize;
+    };
+
+    int n;
+    long long m;
+    bool weighted;
+    const uint64_t *offsets;
+    const uint32_t *targets;
+    const W *weights;
+
+    vector <pair <int, pair <int, W>>> edges;
+    vector <uint64_t> ownOffsets;
+    vector <uint32_t> ownTargets;
+    vector <W> ownWeights;
+    void *mapped;
+    size_t mappedSize;
+
+    CSRGraph (int n = 0, bool weighted = false): n(n), m(0), weighted(weighted), offsets(NULL), targets(NULL),
+        weights(NULL), mapped(NULL), mappedSize(0) {}
+
+    // offsets, targets and weights point into this object's vectors or mapping, so it can be moved but not copied
+    CSRGraph (const CSRGraph&) = delete;
+    CSRGraph& operator = (const CSRGraph&) = delete;
+
+    CSRGraph (CSRGraph&& other): CSRGraph() {
+        Swap(other);
+    }
+
+    CSRGraph& operator = (CSRGraph&& other) {
+        Swap(other);
+        return *this;
+    }
+
+    // swapping vectors keeps their buffers, so the raw pointers stay valid
+    void Swap (CSRGraph& other) {
+        swap(n, other.n), swap(m, other.m), swap(weighted, other.weighted);
+        swap(offsets, other.offsets), swap(targets, other.targets), swap(weights, other.weights);
+        edges.swap(other.edges), ownOffsets.swap(other.ownOffsets);
+        ownTargets.swap(other.ownTargets), ownWeights.swap(other.ownWeights);
+        swap(mapped, other.mapped), swap(mappedSize, other.mappedSize);
+    }
+
+    void AddEdge (int a, int b, W w = W()) {
+        edges.push_back(make_pair(a, make_pair(b, w)));
+    }
+
+    // merges the added edges into the current adjacency with a counting sort, edges of a node keep their order
+    void Build () {
+        vector <uint64_t> nOffsets(n + 1, 0);
+        for (int u = 0; offsets && u < n; ++u) {
+            nOffsets[u + 1] = offsets[u + 1] - offsets[u];
+        }
+        for (auto& e : edges) {
+            nOffsets[e.x + 1]++;
+        }
+        for (int u = 0; u < n; ++u) {
+            nOffsets[u + 1] += nOffsets[u];
+        }
+        vector <uint32_t> nTargets(nOffsets[n]);
+        vector <W> nWeights(weighted ? nOffsets[n] : 0);
+        vector <uint64_t> fill(nOffsets.begin(), nOffsets.end() - 1);
+        for (int u = 0; offsets && u < n; ++u) {
+            for (uint64_t i = offsets[u]; i < offsets[u + 1]; ++i, ++fill[u]) {
+                nTargets[fill[u]] = targets[i];
+                if (weighted) {
+                    nWeights[fill[u]] = weights[i];
+                }
+            }
+        }
+        for (auto& e : edges) {
+            uint64_t i = fill[e.x]++;
+            nTargets[i] = e.y.x;
+            if (weighted) {
+                nWeights[i] = e.y.y;
+            }
+        }
+        Unmap();
+        m = nOffsets[n];
+        ownOffsets.swap(nOffsets), ownTargets.swap(nTargets), ownWeights.swap(nWeights);
+        edges.clear();
+        edges.shrink_to_fit();
+        offsets = ownOffsets.data(), targets = ownTargets.data(), weights = weighted ? ownWeights.data() : NULL;
+    }
+
+    void Flush () {
+        if (!offsets || !edges.empty()) {
+            Build();
+        }
+    }
+
+    static size_t Align (size_t bytes) {
+        return (bytes + 7) & ~size_t(7);
+    }
+
+    bool Write (const char *path) const {
+        FILE *f = fopen(path, "wb");
+        if (!f) {
+            return false;
+        }
+        Header h = {{'C', 'S', 'R', 'G'}, 1, uint64_t(n), uint64_t(m), weighted ? sizeof(W) : 0};
+        const char zero[8] = {0};
+        bool ok = fwrite(&h, sizeof(h), 1, f) == 1;
+        ok = ok && fwrite(offsets, sizeof(uint64_t), n + 1, f) == size_t(n + 1);
+        ok = ok && fwrite(targets, sizeof(uint32_t), m, f) == size_t(m);
+        size_t pad = Align(m * sizeof(uint32_t)) - m * sizeof(uint32_t);
+        ok = ok && fwrite(zero, 1, pad, f) == pad;
+        if (weighted) {
+            ok = ok && fwrite(weights, sizeof(W), m, f) == size_t(m);
+        }
+        return fclose(f) == 0 && ok;
+    }
+
+    // maps the file read-only, returns false on I/O error or malformed header
+    bool Load (const char *path) {
+        Unmap();
+        int fd = open(path, O_RDONLY);
+        if (fd < 0) {
+            return false;
+        }
+        struct stat st;
+        if (fstat(fd, &st) != 0 || size_t(st.st_size) < sizeof(Header)) {
+            close(fd);
+            return false;
+        }
+        mappedSize = st.st_size;
+        mapped = mmap(NULL, mappedSize, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if (mapped == MAP_FAILED) {
+            mapped = NULL;
+            return false;
+        }
+
+        const char *base = (const char *) mapped;
+        const Header *h = (const Header *) base;
+        // n and m are bounded by the file size first, so the section sizes below can't overflow
+        if (memcmp(h->magic, "CSRG", 4) != 0 || h->version != 1 || (h->weightSize != 0 && h->weightSize != sizeof(W)) ||
+                h->n >= uint64_t(INT_MAX) || h->n >= mappedSize / sizeof(uint64_t) || h->m > mappedSize / sizeof(uint32_t)) {
+            Unmap();
+            return false;
+        }
+        size_t offsetsBytes = (h->n + 1) * sizeof(uint64_t), targetsBytes = Align(h->m * sizeof(uint32_t));
+        size_t expected = sizeof(Header) + offsetsBytes + targetsBytes + h->m * h->weightSize;
+        if (mappedSize < expected) {
+            Unmap();
+            return false;
+        }
+        const uint64_t *o = (const uint64_t *) (base + sizeof(Header));
+        bool sorted = o[0] == 0 && o[h->n] == h->m;
+        for (uint64_t u = 0; sorted && u < h->n; ++u) {
+            sorted = o[u] <= o[u + 1];
+        }
+        if (!sorted) {
+            Unmap();
+            return false;
+        }
+        madvise(mapped, mappedSize, MADV_SEQUENTIAL);
+
+        n = h->n, m = h->m, weighted = h->weightSize != 0;
+        offsets = o;
+        targets = (const uint32_t *) (base + sizeof(Header) + offsetsBytes);
+        weights = weighted ? (const W *) (base + sizeof(Header) + offsetsBytes + targetsBytes) : NULL;
+        return true;
+    }
+
+    void Unmap () {
+        if (mapped) {
+            munmap(mapped, mappedSize);
+            mapped = NULL, mappedSize = 0;
+            offsets = NULL, targets = NULL, weights = NULL;
+        }
+    }
+
+    const uint32_t *Begin (int u) const {
+        return targets + offsets[u];
+    }
+
+    const uint32_t *End (int u) const {
+        return targets + offsets[u + 1];
+    }
+
+    W Weight (uint64_t i) const {
+        return weighted ? weights[i] : W(1);
+    }
+
+    template <class F> void ForEachEdge (F f) const {
+        for (int u = 0; u < n; ++u) {
+            for (uint64_t i = offsets[u]; i < offsets[u + 1]; ++i) {
+                f(u, int(targets[i]), Weight(i));
+            }
+        }
+    }
+
+    ~CSRGraph () {
+        Unmap();
+    }
+};
+
+/*
+    Implementation of 2-SAT solver with an iterative Tarjan pass over a CSR implication graph
+
+    Running time:
+        O(n + m) per Solve(), where m is the number of clauses
+
+    Usage:
+        - literals: Lit(v, true) is x_v, Lit(v, false) is !x_v, Not(l) negates a literal
+        - add clauses by AddClause(a, b) (a or b), AddImplication(a, b) (a -> b), ForceTrue(a)
+        - clauses are batched and merged into the CSRGraph of implications on the next Solve()
+        - Solve(assumptions) solves with every literal in assumptions forced true, the assumptions
+        are not stored, so the same instance can be solved repeatedly under different assumptions
+
+    Input:
+        - n, number of variables
+        - clauses, constructed using AddClause()
+
+    Output:
+        - true iff the formula is satisfiable
+        - value, value[v] is the assignment of x_v {0: false, 1: true}
+
+    Tested Problems:
+*/
+
+struct TwoSat {
+    int n;
+    CSRGraph <> graph;
+    vector <int> idx, low, componentOf, st, call, edge, value;
+    vector <bool> inStack, assumed;
+
+    TwoSat (int n): n(n), graph(2 * n), assumed(2 * n, false) {}
+
+    static int Lit (int v, bool positive = true) {
+        return 2 * v + (positive ? 0 : 1);
+    }
+
+    static int Not (int a) {
+        return a ^ 1;
+    }
+
+    void AddImplication (int a, int b) {
+        graph.AddEdge(a, b);
+    }
+
+    void AddClause (int a, int b) {
+        AddImplication(Not(a), b);
+        AddImplication(Not(b), a);
+    }
+
+    void ForceTrue (int a) {
+        AddImplication(Not(a), a);
+    }
+
+    // i-th outgoing edge of u, an assumed literal a adds the virtual edge !a -> a
+    int Target (int u, int i) {
+        return i < int(graph.offsets[u + 1]) ? int(graph.targets[i]) : Not(u);
+    }
+
+    int Degree (int u) {
+        return int(graph.offsets[u + 1]) + (assumed[Not(u)] ? 1 : 0);
+    }
+
+    bool Solve (const vector <int>& assumptions = vector <int>()) {
+        graph.Flush();
+        int N = 2 * n, index = 0, totalComponents = 0;
+        for (auto& a : assumptions) {
+            assumed[a] = true;
+        }
+        idx.assign(N, -1), low.assign(N, 0), componentOf.assign(N, -1);
+        inStack.assign(N, false), edge.assign(N, 0);
+        st.clear(), call.clear();
+
+        for (int s = 0; s < N; ++s) {
+            if (idx[s] != -1) {
+                continue;
+            }
+            call.push_back(s);
+            idx[s] = low[s] = index++, edge[s] = graph.offsets[s];
+            st.push_back(s), inStack[s] = true;
+            while (!call.empty()) {
+                int v = call.back();
+                if (edge[v] < Degree(v)) {
+                    int w = Target(v, edge[v]++);
+                    if (idx[w] == -1) {
+                        idx[w] = low[w] = index++, edge[w] = graph.offsets[w];
+                        st.push_back(w), inStack[w] = true;
+                        call.push_back(w);
+                    } else if (inStack[w]) {
+                        low[v] = min(low[v], idx[w]);
+                    }
+                    continue;
+                }
+                call.pop_back();
+                if (!call.empty()) {
+                    low[call.back()] = min(low[call.back()], low[v]);
+                }
+                if (low[v] == idx[v]) {
+                    int w;
+                    do {
+                        w = st.back();
+                        st.pop_back();
+                        inStack[w] = false;
+                        componentOf[w] = totalComponents;
+                    } while (w != v);
+                    totalComponents++;
+                }
+            }
+        }
+
+        for (auto& a : assumptions) {
+            assumed[a] = false;
+        }
+        // Tarjan numbers components in reverse topological order
+        value.assign(n, 0);
+        for (int v = 0; v < n; ++v) {
+            if (componentOf[2 * v] == componentOf[2 * v + 1]) {
+                return false;
+            }
+            value[v] = componentOf[2 * v] < componentOf[2 * v + 1];
+        }
+        return true;
+    }
+};
+
 
 /*
     Implementation of Kruskal's minimum spanning tree algorithm
@@ -240,15 +710,23 @@ template <class T> struct Dijkstra {
     }
 
     void BuildTree (int s, vector<T>& dist) {
-        dist = vector <T>(n, inf);
-        parent = vector <int>(n, -1);
-        priority_queue <pair <T, vector<pair <T, int>>>, vector<pair <T, int>>, greater<pair <T, int>>> q;
+        BuildTree(s, dist, parent);
+    }
+
+    // doesn't touch any member, so several trees can be built in parallel
+    void BuildTree (int s, vector <T>& dist, vector <int>& parent) const {
+        dist.assign(n, inf);
+        parent.assign(n, -1);
+        priority_queue <pair <T, int>, vector<pair <T, int>>, greater<pair <T, int>>> q;
 
         dist[s] = 0;
         q.push(make_pair(dist[s], s));
         do {
-            auto& u = q.top();
+            auto u = q.top();
             q.pop();
+            if (u.x > dist[u.y]) {
+                continue;
+            }
             for (auto& e : adj[u.y]) {
                 if (u.x + e.x < dist[e.y]) {
                     dist[e.y] = u.x + e.x;
@@ -262,101 +740,471 @@ template <class T> struct Dijkstra {
 
 
 /*
-    Finds biconnected components, bridges and articulation points in a graph
+    Implementation of Bellman-Ford single source shortest path algorithm, with SPFA queue mode
+    and negative cycle extraction
 
     Running time:
-        O(|V|+|E|)
+        - BuildTree(): O(|V||E|), stops as soon as a pass relaxes nothing
+        - SPFA(): O(|V||E|) worst case, usually close to O(|E|)
 
     Usage:
-        - add edges by AddEdge()
-        - call BuildBCC() to find all biconnected components, bridges and articulation points
+        - add edges by AddEdge(), edges are stored as a struct of arrays and scanned sequentially,
+        SPFA() packs them into a CSRGraph
+        - BuildTree (s, dist) runs relaxation passes, SPFA (s, dist) runs the queue based version
+        with Small Label First and Large Label Last heuristics
+        - use s = -1 to start from every node at distance 0, which finds any negative cycle in the graph
+        - both return false iff a negative cycle is reachable, it is then stored in cycle
 
     Input:
+        - n, number of nodes
         - graph, constructed using AddEdge()
+        - source
 
     Output:
-        - components, vector of vectors, where each subvector is a biconnected component.
-        - bridges, index of the edges which are bridge
-        - cutVertices, index of the nodes which are articulation points
-
-    Todo:
-        - Implementat 2-connected components finding algorithm
+        - dist, dist[v] is the distance of v from source (inf if unreachable)
+        - parent, parent[v] is the parent of v in the tree
+        - cycle, nodes of a negative cycle in order, cycle[i] -> cycle[i + 1] is an edge
 
     Tested Problems:
 */
 
-struct BiconnectedComponents {
+template <class T> struct BellmanFord {
     int n;
-    int totalComponents;
-    vector <vector <pair <int, int>>> adj;
-    vector <pair <int, int>> edges;
-    vector <int> idx, low;
-    vector <int> cutVertices, bridges;
-    vector <int> st;
-    vector <vector <int>> components;
+    vector <int> from, to, parent, cycle;
+    vector <T> weight;
 
-    BiconnectedComponents (int n): n(n), adj(n) {}
+    BellmanFord (int n): n(n) {}
 
-    void AddEdge (int a, int b) {
-        int i = edges.size();
-        adj[a].push_back(make_pair(b, i));
-        adj[b].push_back(make_pair(a, i));
-        edges.push_back(make_pair(a, b));
+    void AddEdge (int a, int b, T d) {
+        from.push_back(a), to.push_back(b), weight.push_back(d);
     }
 
-    int DFS (PI v, int index) {
-        idx[v.x] = index;
-        low[v.x] = index;
-        index += 1;
+    void Init (int s, vector <T>& dist) {
+        dist.assign(n, s == -1 ? T(0) : T(inf));
+        parent.assign(n, -1);
+        cycle.clear();
+        if (s != -1) {
+            dist[s] = 0;
+        }
+    }
 
-        int children = 0;
-        bool ap = false;
-        for (auto& w : adj[v.x]) {
-            if (w.y != v.y) {
-                if (idx[w.x] == -1) {
-                    st.push_back(w.y);
-                    index = DFS(w, index);
-                    low[v.x] = min(low[v.x], low[w.x]);
-                    if (low[w.x] > idx[v.x]) {
-                        bridges.push_back(w.y);
-                    }
-                    children++;
-                    if (low[w.x] >= idx[v.x]) {
-                        if (v.y != -1 || children >= 2) {
-                            ap = true;
-                        }
-                        components.push_back(vector <int>());
-                        totalComponents++;
-                        int u;
-                        do {
-                            u = st.back();
-                            st.pop_back();
-                            components.back().push_back(u);
-                        } while (u != w.y);
-                    }
-                } else if (idx[w.x] < idx[v.x]) {
-                    st.push_back(w.y);
-                    low[v.x] = min(low[v.x], idx[w.x]);
+    bool BuildTree (int s, vector <T>& dist) {
+        Init(s, dist);
+        int m = from.size(), last = -1;
+        const int *a = from.data(), *b = to.data();
+        const T *w = weight.data();
+        T *d = dist.data();
+        for (int pass = 0; pass < n; ++pass) {
+            last = -1;
+            for (int i = 0; i < m; ++i) {
+                if (d[a[i]] < T(inf) && d[a[i]] + w[i] < d[b[i]]) {
+                    d[b[i]] = d[a[i]] + w[i];
+                    parent[b[i]] = a[i];
+                    last = b[i];
                 }
             }
+            if (last == -1) {
+                return true;
+            }
         }
-        if (ap) {
-            cutVertices.push_back(v.x);
+        // a node relaxed in the n-th pass leads back into a negative cycle through parents
+        for (int i = 0; i < n; ++i) {
+            last = parent[last];
         }
-        return index;
+        ExtractCycle(last);
+        return false;
     }
 
-    void BuildBCC () {
-        idx = vector <int>(n, -1), low = vector <int>(n);
-        cutVertices.clear();
-        bridges.clear();
-        st.clear();
-        components.clear();
-        totalComponents++;
-
-        for (int i = 0; i < n; i++) {
-            if (idx[i] == -1) {
-                DFS(make_pair(i, -1), 0);
+    bool SPFA (int s, vector <T>& dist) {
+        Init(s, dist);
+        CSRGraph <T> G(n, true);
+        for (size_t i = 0; i < from.size(); ++i) {
+            G.AddEdge(from[i], to[i], weight[i]);
+        }
+        G.Build();
+
+        deque <int> q;
+        vector <bool> inQueue(n, false);
+        // sum of the labels in the queue, kept outside of T so that it can't overflow
+        long double sum = 0;
+        for (int u = 0; u < n; ++u) {
+            if (s == -1 || u == s) {
+                q.push_back(u), inQueue[u] = true;
+            }
+        }
+        long long relaxations = 0;
+        while (!q.empty()) {
+            // Large Label Last
+            for (size_t k = q.size(); k > 1 && (long double) dist[q.front()] * q.size() > sum; --k) {
+                q.push_back(q.front());
+                q.pop_front();
+            }
+            int u = q.front();
+            q.pop_front();
+            inQueue[u] = false;
+            sum -= (long double) dist[u];
+            for (uint64_t i = G.offsets[u]; i < G.offsets[u + 1]; ++i) {
+                int v = G.targets[i];
+                if (dist[u] + G.weights[i] < dist[v]) {
+                    if (inQueue[v]) {
+                        sum -= (long double) dist[v];
+                    }
+                    dist[v] = dist[u] + G.weights[i];
+                    parent[v] = u;
+                    sum += (long double) dist[v];
+                    if (!inQueue[v]) {
+                        inQueue[v] = true;
+                        // Small Label First
+                        if (!q.empty() && dist[v] < dist[q.front()]) {
+                            q.push_front(v);
+                        } else {
+                            q.push_back(v);
+                        }
+                    }
+                    // the parent graph contains a cycle iff a negative cycle has been found
+                    if (++relaxations % n == 0 && FindParentCycle()) {
+                        return false;
+                    }
+                }
+            }
+        }
+        return true;
+    }
+
+    bool FindParentCycle () {
+        vector <int> stamp(n, -1);
+        for (int v = 0; v < n; ++v) {
+            int u = v;
+            while (u != -1 && stamp[u] == -1) {
+                stamp[u] = v;
+                u = parent[u];
+            }
+            if (u != -1 && stamp[u] == v) {
+                ExtractCycle(u);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void ExtractCycle (int u) {
+        cycle.clear();
+        int v = u;
+        do {
+            cycle.push_back(v);
+            v = parent[v];
+        } while (v != u);
+        reverse(cycle.begin(), cycle.end());
+    }
+};
+
+/*
+    Runs f(t, id) for every task t in [0, tasks) over the given number of threads, tasks are handed out
+    by an atomic counter and id in [0, threads) is the thread running the task, for per-thread workspaces
+
+    Usage:
+        - requires -pthread
+*/
+
+template <class F> void ParallelFor (int tasks, int threads, F f) {
+    atomic <int> counter(0);
+    auto worker = [&](int id) {
+        for (int t; (t = counter++) < tasks; ) {
+            f(t, id);
+        }
+    };
+    vector <thread> pool;
+    for (int i = 1; i < min(threads, tasks); ++i) {
+        pool.push_back(thread(worker, i));
+    }
+    worker(0);
+    for (auto& t : pool) {
+        t.join();
+    }
+}
+
+/*
+    Implementation of blocked (tiled) Floyd-Warshall all pairs shortest path algorithm
+
+    Running time:
+        O(|V|^3), the matrix is split in B x B tiles, for each diagonal tile the three phases
+        (diagonal tile, its row and column, everything else) update tiles that fit in L1/L2
+        cache, and the tiles of the second and third phase are distributed over threads
+
+    Usage:
+        - requires -pthread
+        - add edges by AddEdge(), call Run(threads)
+        - Dist (i, j) is the distance from i to j (infinity if unreachable)
+        - if paths is true, Path (i, j, path) stores the nodes of a shortest path from i to j
+        - there is a negative cycle iff Dist (i, i) < 0 for some i
+
+    Input:
+        - n, number of nodes
+        - paths, true iff path reconstruction is needed (an extra n x n matrix of int)
+        - infinity, distance of unreachable pairs, default is inf like the other shortest path engines,
+        it is never added to anything, so only sums of two finite distances must fit in T
+
+    Output:
+        - dist, flat row-major N x N matrix, N is n rounded up to a multiple of B
+        - next, next[i * N + j] is the node after i on a shortest path from i to j
+
+    Tested Problems:
+*/
+
+template <class T> struct FloydWarshall {
+    static const int B = 64;
+    int n, N;
+    bool paths;
+    T infinity;
+    vector <T> dist;
+    vector <int> next;
+
+    FloydWarshall (int n, bool paths = false, T infinity = T(inf)): n(n), N((n + B - 1) / B * B), paths(paths),
+        infinity(infinity), dist(size_t(N) * N, infinity), next(paths ? size_t(N) * N : 0, -1) {
+        for (int i = 0; i < N; ++i) {
+            dist[size_t(i) * N + i] = 0;
+            if (paths) {
+                next[size_t(i) * N + i] = i;
+            }
+        }
+    }
+
+    void AddEdge (int a, int b, T d) {
+        size_t i = size_t(a) * N + b;
+        if (d < dist[i]) {
+            dist[i] = d;
+            if (paths) {
+                next[i] = b;
+            }
+        }
+    }
+
+    T Dist (int i, int j) const {
+        return dist[size_t(i) * N + j];
+    }
+
+    // min-plus update of tile C = (ci, cj) through tile K = kb, A = (ci, kb), B = (kb, cj),
+    // unreachable entries of A and B never relax C, even through negative edges
+    void Tile (int ci, int cj, int kb) {
+        for (int k = kb * B; k < (kb + 1) * B; ++k) {
+            const T *bk = &dist[size_t(k) * N + cj * B];
+            for (int i = ci * B; i < (ci + 1) * B; ++i) {
+                T aik = dist[size_t(i) * N + k];
+                if (aik >= infinity) {
+                    continue;
+                }
+                T *ci_ = &dist[size_t(i) * N + cj * B];
+                if (paths) {
+                    int *ni = &next[size_t(i) * N + cj * B], nik = next[size_t(i) * N + k];
+                    for (int j = 0; j < B; ++j) {
+                        T cand = bk[j] < infinity ? aik + bk[j] : infinity;
+                        bool better = cand < ci_[j];
+                        ci_[j] = better ? cand : ci_[j];
+                        ni[j] = better ? nik : ni[j];
+                    }
+                } else {
+                    for (int j = 0; j < B; ++j) {
+                        ci_[j] = min(ci_[j], bk[j] < infinity ? aik + bk[j] : infinity);
+                    }
+                }
+            }
+        }
+    }
+
+    void Run (int threads = max(1u, thread::hardware_concurrency())) {
+        int nb = N / B;
+        for (int kb = 0; kb < nb; ++kb) {
+            Tile(kb, kb, kb);
+            ParallelFor(2 * (nb - 1), threads, [&](int t, int) {
+                int other = t / 2 < kb ? t / 2 : t / 2 + 1;
+                if (t & 1) {
+                    Tile(other, kb, kb);
+                } else {
+                    Tile(kb, other, kb);
+                }
+            });
+            ParallelFor((nb - 1) * (nb - 1), threads, [&](int t, int) {
+                int i = t / (nb - 1), j = t % (nb - 1);
+                Tile(i < kb ? i : i + 1, j < kb ? j : j + 1, kb);
+            });
+        }
+    }
+
+    // returns false if j is unreachable from i
+    bool Path (int i, int j, vector <int>& path) const {
+        path.clear();
+        if (Dist(i, j) >= infinity) {
+            return false;
+        }
+        path.push_back(i);
+        while (i != j && int(path.size()) <= n) {
+            i = next[size_t(i) * N + j];
+            if (i == -1) {
+                return false;
+            }
+            path.push_back(i);
+        }
+        return i == j;
+    }
+};
+
+/*
+    Implementation of Johnson's all pairs shortest path algorithm
+
+    Running time:
+        O(|V||E| + |V|(|V|log|V| + |E|) / threads)
+
+    Usage:
+        - requires -pthread
+        - add edges by AddEdge(), call Run(dist, threads)
+        - potentials are computed once by BellmanFord from a virtual source, then every edge is
+        reweighted to be non-negative and one Dijkstra tree is built from every source, the sources
+        are distributed over threads and every thread owns its dist/parent workspace
+
+    Input:
+        - n, number of nodes
+        - graph, constructed using AddEdge()
+
+    Output:
+        - false iff there is a negative cycle
+        - dist, flat row-major n x n matrix, dist[u * n + v] is the distance from u to v (inf if unreachable)
+
+    Tested Problems:
+*/
+
+template <class T> struct Johnson {
+    int n;
+    BellmanFord <T> potentials;
+    vector <T> h;
+
+    Johnson (int n): n(n), potentials(n) {}
+
+    void AddEdge (int a, int b, T d) {
+        potentials.AddEdge(a, b, d);
+    }
+
+    bool Run (vector <T>& dist, int threads = max(1u, thread::hardware_concurrency())) {
+        if (!potentials.SPFA(-1, h)) {
+            return false;
+        }
+        Dijkstra <T> D(n, true);
+        for (size_t i = 0; i < potentials.from.size(); ++i) {
+            int a = potentials.from[i], b = potentials.to[i];
+            D.addEdge(a, b, potentials.weight[i] + h[a] - h[b]);
+        }
+
+        dist.assign(size_t(n) * n, T(inf));
+        vector <vector <T>> d(max(1, threads));
+        vector <vector <int>> parent(max(1, threads));
+        ParallelFor(n, threads, [&](int s, int id) {
+            D.BuildTree(s, d[id], parent[id]);
+            T *row = &dist[size_t(s) * n];
+            for (int v = 0; v < n; ++v) {
+                if (d[id][v] < T(inf)) {
+                    row[v] = d[id][v] - h[s] + h[v];
+                }
+            }
+        });
+        return true;
+    }
+};
+
+/*
+    Finds biconnected components, bridges and articulation points in a graph
+
+    Running time:
+        O(|V|+|E|)
+
+    Usage:
+        - add edges by AddEdge()
+        - call BuildBCC() to find all biconnected components, bridges and articulation points
+
+    Input:
+        - graph, constructed using AddEdge()
+
+    Output:
+        - components, vector of vectors, where each subvector is a biconnected component.
+        - bridges, index of the edges which are bridge
+        - cutVertices, index of the nodes which are articulation points
+
+    Todo:
+        - Implementat 2-connected components finding algorithm
+
+    Tested Problems:
+*/
+
+struct BiconnectedComponents {
+    int n;
+    int totalComponents;
+    vector <vector <pair <int, int>>> adj;
+    vector <pair <int, int>> edges;
+    vector <int> idx, low;
+    vector <int> cutVertices, bridges;
+    vector <int> st;
+    vector <vector <int>> components;
+
+    BiconnectedComponents (int n): n(n), adj(n) {}
+
+    void AddEdge (int a, int b) {
+        int i = edges.size();
+        adj[a].push_back(make_pair(b, i));
+        adj[b].push_back(make_pair(a, i));
+        edges.push_back(make_pair(a, b));
+    }
+
+    int DFS (PI v, int index) {
+        idx[v.x] = index;
+        low[v.x] = index;
+        index += 1;
+
+        int children = 0;
+        bool ap = false;
+        for (auto& w : adj[v.x]) {
+            if (w.y != v.y) {
+                if (idx[w.x] == -1) {
+                    st.push_back(w.y);
+                    index = DFS(w, index);
+                    low[v.x] = min(low[v.x], low[w.x]);
+                    if (low[w.x] > idx[v.x]) {
+                        bridges.push_back(w.y);
+                    }
+                    children++;
+                    if (low[w.x] >= idx[v.x]) {
+                        if (v.y != -1 || children >= 2) {
+                            ap = true;
+                        }
+                        components.push_back(vector <int>());
+                        totalComponents++;
+                        int u;
+                        do {
+                            u = st.back();
+                            st.pop_back();
+                            components.back().push_back(u);
+                        } while (u != w.y);
+                    }
+                } else if (idx[w.x] < idx[v.x]) {
+                    st.push_back(w.y);
+                    low[v.x] = min(low[v.x], idx[w.x]);
+                }
+            }
+        }
+        if (ap) {
+            cutVertices.push_back(v.x);
+        }
+        return index;
+    }
+
+    void BuildBCC () {
+        idx = vector <int>(n, -1), low = vector <int>(n);
+        cutVertices.clear();
+        bridges.clear();
+        st.clear();
+        components.clear();
+        totalComponents++;
+
+        for (int i = 0; i < n; i++) {
+            if (idx[i] == -1) {
+                DFS(make_pair(i, -1), 0);
             }
         }
     }
@@ -900,3 +1748,759 @@ template <class T> struct PushRelabel {
         return ret;
     }
 };
+
+/*
+    Implementation of Heavy-Light Decomposition
+
+    Running time:
+        O(|V|) to build, O(log^2|V|) per path query with a O(log|V|) backend
+
+    Usage:
+        - add edges by AddEdge(), call Build(root)
+        - node v is stored at position pos[v] of the backend (SegmentTree, FenwickTree, RangeFenwickTree),
+        every heavy chain occupies a contiguous range of positions
+        - ForEachPath (u, v, f) calls f(l, r) for O(log|V|) ranges [l, r) covering the path u - v
+        - with edges = true, the value of edge (p, c) is stored at pos[c] and the LCA is skipped
+        - QueryPath (tree, u, v) folds a SegmentTree over the path (F must be commutative)
+        - path update / path sum with a RangeFenwickTree:
+            H.ForEachPath(u, v, [&](int l, int r) { R.Add(l, r, val); });
+            H.ForEachPath(u, v, [&](int l, int r) { sum += R.Sum(l, r); });
+
+    Input:
+        - graph, a tree constructed using AddEdge()
+        - root, root of the tree, default is 0
+
+    Output:
+        - parent, depth, heavy, head, pos, order (order[pos[v]] = v)
+
+    Tested Problems:
+*/
+
+struct HeavyLightDecomposition {
+    int n;
+    vector <vector <int>> adj;
+    vector <int> parent, depth, heavy, head, pos, order;
+
+    HeavyLightDecomposition (int n): n(n), adj(n) {}
+
+    void AddEdge (int a, int b) {
+        adj[a].push_back(b);
+        adj[b].push_back(a);
+    }
+
+    void Build (int root = 0) {
+        parent.assign(n, -1), depth.assign(n, 0), heavy.assign(n, -1), head.assign(n, 0), pos.assign(n, 0);
+        order.clear();
+
+        // BFS order, so that children are processed after their parents
+        vector <int> bfs(1, root), size(n, 1);
+        for (int i = 0; i < int(bfs.size()); ++i) {
+            int u = bfs[i];
+            for (auto& v : adj[u]) {
+                if (v != parent[u]) {
+                    parent[v] = u, depth[v] = depth[u] + 1;
+                    bfs.push_back(v);
+                }
+            }
+        }
+        for (int i = int(bfs.size()) - 1; i > 0; --i) {
+            int v = bfs[i], p = parent[v];
+            size[p] += size[v];
+            if (heavy[p] == -1 || size[v] > size[heavy[p]]) {
+                heavy[p] = v;
+            }
+        }
+        for (auto& u : bfs) {
+            if (u == root || heavy[parent[u]] != u) {
+                for (int v = u; v != -1; v = heavy[v]) {
+                    head[v] = u, pos[v] = order.size();
+                    order.push_back(v);
+                }
+            }
+        }
+    }
+
+    template <class F> void ForEachPath (int u, int v, F f, bool edges = false) {
+        for (; head[u] != head[v]; u = parent[head[u]]) {
+            if (depth[head[u]] < depth[head[v]]) {
+                swap(u, v);
+            }
+            f(pos[head[u]], pos[u] + 1);
+        }
+        if (depth[u] > depth[v]) {
+            swap(u, v);
+        }
+        if (pos[u] + edges <= pos[v]) {
+            f(pos[u] + edges, pos[v] + 1);
+        }
+    }
+
+    int LCA (int u, int v) {
+        for (; head[u] != head[v]; u = parent[head[u]]) {
+            if (depth[head[u]] < depth[head[v]]) {
+                swap(u, v);
+            }
+        }
+        return depth[u] < depth[v] ? u : v;
+    }
+
+    template <class T, class F> T QueryPath (const SegmentTree <T, F>& tree, int u, int v, bool edges = false) {
+        T ret = tree.identity;
+        ForEachPath(u, v, [&](int l, int r) {
+            ret = tree.f(ret, tree.Query(l, r));
+        }, edges);
+        return ret;
+    }
+};
+
+/*
+    Implementation of Stoer-Wagner global minimum cut algorithm for undirected graphs
+
+    Running time:
+        - MinCut(): O(|V||E|log|V|), maximum adjacency search with a binary heap
+        - DenseMinCut(): O(|V|^3), on a flat n x n weight matrix
+
+    Usage:
+        - add edges by AddEdge(), parallel edges are summed up
+        - MinCut (side) or DenseMinCut (side) returns the weight of a minimum cut
+
+    Input:
+        - n, number of nodes (at least 2)
+        - graph, constructed using AddEdge(), weights must be non-negative
+
+    Output:
+        - weight of the global minimum cut
+        - side, the two parts of the cut are {v : side[v]} and {v : !side[v]}
+
+    Tested Problems:
+*/
+
+template <class T> struct StoerWagner {
+    int n;
+    vector <pair <int, pair <int, T>>> edges;
+
+    StoerWagner (int n): n(n) {}
+
+    void AddEdge (int a, int b, T w) {
+        if (a != b) {
+            edges.push_back(make_pair(a, make_pair(b, w)));
+        }
+    }
+
+    // members[v] lists the original nodes merged into v, the best phase cut is copied into side
+    void Record (const vector <vector <int>>& members, int t, vector <bool>& side) {
+        side.assign(n, false);
+        for (auto& v : members[t]) {
+            side[v] = true;
+        }
+    }
+
+    T MinCut (vector <bool>& side) {
+        vector <map <int, T>> adj(n);
+        for (auto& e : edges) {
+            adj[e.x][e.y.x] += e.y.y;
+            adj[e.y.x][e.x] += e.y.y;
+        }
+        vector <vector <int>> members(n);
+        vector <int> alive;
+        for (int v = 0; v < n; ++v) {
+            members[v].assign(1, v);
+            alive.push_back(v);
+        }
+
+        T best = numeric_limits <T>::max();
+        vector <T> key(n);
+        vector <int> added(n, -1);
+        for (int phase = 0; int(alive.size()) > 1; ++phase) {
+            priority_queue <pair <T, int>> q;
+            for (auto& v : alive) {
+                key[v] = 0;
+                q.push(make_pair(T(0), v));
+            }
+            int s = -1, t = -1;
+            while (!q.empty()) {
+                auto u = q.top();
+                q.pop();
+                if (added[u.y] == phase || u.x != key[u.y]) {
+                    continue;
+                }
+                added[u.y] = phase;
+                s = t, t = u.y;
+                for (auto& e : adj[u.y]) {
+                    if (added[e.x] != phase) {
+                        key[e.x] += e.y;
+                        q.push(make_pair(key[e.x], e.x));
+                    }
+                }
+            }
+
+            if (key[t] < best) {
+                best = key[t];
+                Record(members, t, side);
+            }
+
+            // merge t into s
+            members[s].insert(members[s].end(), members[t].begin(), members[t].end());
+            for (auto& e : adj[t]) {
+                if (e.x != s) {
+                    adj[s][e.x] += e.y;
+                    adj[e.x][s] += e.y;
+                }
+                adj[e.x].erase(t);
+            }
+            adj[t].clear();
+            alive.erase(find(alive.begin(), alive.end(), t));
+        }
+        return best;
+    }
+
+    T DenseMinCut (vector <bool>& side) {
+        vector <T> w(size_t(n) * n, T(0));
+        for (auto& e : edges) {
+            w[size_t(e.x) * n + e.y.x] += e.y.y;
+            w[size_t(e.y.x) * n + e.x] += e.y.y;
+        }
+        vector <vector <int>> members(n);
+        vector <int> alive;
+        for (int v = 0; v < n; ++v) {
+            members[v].assign(1, v);
+            alive.push_back(v);
+        }
+
+        T best = numeric_limits <T>::max();
+        vector <T> key(n);
+        vector <bool> added(n);
+        while (alive.size() > 1) {
+            for (auto& v : alive) {
+                key[v] = 0, added[v] = false;
+            }
+            int s = -1, t = -1;
+            for (size_t k = 0; k < alive.size(); ++k) {
+                int u = -1;
+                for (auto& v : alive) {
+                    if (!added[v] && (u == -1 || key[v] > key[u])) {
+                        u = v;
+                    }
+                }
+                added[u] = true;
+                s = t, t = u;
+                const T *row = &w[size_t(u) * n];
+                for (auto& v : alive) {
+                    key[v] += row[v];
+                }
+            }
+
+            if (key[t] < best) {
+                best = key[t];
+                Record(members, t, side);
+            }
+
+            members[s].insert(members[s].end(), members[t].begin(), members[t].end());
+            for (auto& v : alive) {
+                w[size_t(s) * n + v] += w[size_t(t) * n + v];
+                w[size_t(v) * n + s] = w[size_t(s) * n + v];
+            }
+            w[size_t(s) * n + s] = 0;
+            alive.erase(find(alive.begin(), alive.end(), t));
+        }
+        return best;
+    }
+};
+
+/*
+    Implementation of Tarjan's (Gabow et al.) minimum arborescence (Directed MST) algorithm,
+    with lazy skew heaps of incoming edges and a rollback union-find for contracted cycles
+
+    Running time:
+        O(|E|log|E|)
+
+    Usage:
+        - add edges by AddEdge()
+        - Solve (root, weight, chosen) finds a minimum weight spanning arborescence rooted at root
+
+    Input:
+        - n, number of nodes
+        - graph, constructed using AddEdge()
+        - root
+
+    Output:
+        - false iff some node is unreachable from root
+        - weight, total weight of the arborescence
+        - chosen, chosen[v] is the index (in the order of AddEdge() calls) of the edge entering v,
+        -1 for root
+        - parent, parent[v] is the parent of v in the arborescence
+
+    Tested Problems:
+*/
+
+template <class T> struct DirectedMST {
+    int n;
+    vector <int> from, to, left, right;
+    vector <T> weight, lazy;
+    vector <int> uf, history, parent;
+
+    DirectedMST (int n): n(n) {}
+
+    void AddEdge (int a, int b, T w) {
+        from.push_back(a), to.push_back(b), weight.push_back(w);
+    }
+
+    // skew heap of edge indices, lazy[x] is added to every key in the subtree of x
+    void Push (int x) {
+        weight[x] += lazy[x];
+        if (left[x] != -1) {
+            lazy[left[x]] += lazy[x];
+        }
+        if (right[x] != -1) {
+            lazy[right[x]] += lazy[x];
+        }
+        lazy[x] = 0;
+    }
+
+    int Merge (int a, int b) {
+        if (a == -1 || b == -1) {
+            return a == -1 ? b : a;
+        }
+        Push(a), Push(b);
+        if (weight[b] < weight[a]) {
+            swap(a, b);
+        }
+        right[a] = Merge(right[a], b);
+        swap(left[a], right[a]);
+        return a;
+    }
+
+    // union-find by size without path compression, so that unions can be rolled back
+    int Find (int x) {
+        while (uf[x] >= 0) {
+            x = uf[x];
+        }
+        return x;
+    }
+
+    bool Join (int a, int b) {
+        a = Find(a), b = Find(b);
+        if (a == b) {
+            return false;
+        }
+        if (uf[a] > uf[b]) {
+            swap(a, b);
+        }
+        history.push_back(b), history.push_back(uf[b]);
+        uf[a] += uf[b], uf[b] = a;
+        return true;
+    }
+
+    void Rollback (int time) {
+        while (int(history.size()) > time) {
+            int size = history.back();
+            history.pop_back();
+            int b = history.back();
+            history.pop_back();
+            uf[uf[b]] -= size, uf[b] = size;
+        }
+    }
+
+    bool Solve (int root, T& total, vector <int>& chosen) {
+        int m = from.size();
+        vector <T> original = weight;
+        left.assign(m, -1), right.assign(m, -1), lazy.assign(m, T(0));
+        uf.assign(n, -1), history.clear();
+        vector <int> heap(n, -1);
+        for (int i = 0; i < m; ++i) {
+            heap[to[i]] = Merge(heap[to[i]], i);
+        }
+
+        total = 0;
+        vector <int> seen(n, -1), path(n), picked(n), in(n, -1);
+        seen[root] = root;
+        // contracted cycles: (node, union-find time, edges of the cycle)
+        vector <pair <pair <int, int>, vector <int>>> cycles;
+        bool ok = true;
+        for (int s = 0; s < n && ok; ++s) {
+            int u = s, qi = 0;
+            while (seen[u] < 0) {
+                if (heap[u] == -1) {
+                    ok = false;
+                    break;
+                }
+                int e = heap[u];
+                Push(e);
+                T w = weight[e];
+                lazy[e] -= w;
+                Push(e);
+                heap[u] = Merge(left[e], right[e]);
+                picked[qi] = e, path[qi++] = u, seen[u] = s;
+                total += w, u = Find(from[e]);
+                if (seen[u] == s) {
+                    int cyc = -1, end = qi, time = history.size(), v;
+                    do {
+                        v = path[--qi];
+                        cyc = Merge(cyc, heap[v]);
+                    } while (Join(u, v));
+                    u = Find(u), heap[u] = cyc, seen[u] = -1;
+                    cycles.push_back(make_pair(make_pair(u, time), vector <int>(picked.begin() + qi, picked.begin() + end)));
+                }
+            }
+            for (int i = 0; i < qi; ++i) {
+                in[Find(to[picked[i]])] = picked[i];
+            }
+        }
+        weight = original;
+        if (!ok) {
+            return false;
+        }
+
+        for (int i = int(cycles.size()) - 1; i >= 0; --i) {
+            int u = cycles[i].x.x;
+            Rollback(cycles[i].x.y);
+            int inEdge = in[u];
+            for (auto& e : cycles[i].y) {
+                in[Find(to[e])] = e;
+            }
+            in[Find(to[inEdge])] = inEdge;
+        }
+        chosen = in, parent.assign(n, -1);
+        chosen[root] = -1;
+        for (int v = 0; v < n; ++v) {
+            if (chosen[v] != -1) {
+                parent[v] = from[chosen[v]];
+            }
+        }
+        return true;
+    }
+};
+
+/*
+    Implementation of Gomory-Hu tree by Gusfield's algorithm, on top of PushRelabel::GetMinCut
+
+    Running time:
+        O(|V| * maxflow) to build, O(log|V|) per query
+
+    Usage:
+        - requires -pthread
+        - add undirected edges by AddEdge(), call Build(threads)
+        - with threads > 1, the next batch of sources computes its cuts concurrently, every thread on
+        its own copy of the flow network, and the cuts are committed in order. A cut is recomputed
+        when an earlier cut of the same batch changed the tree parent it was computed against
+        - MinCut (u, v) returns the value of the minimum u-v cut
+
+    Input:
+        - n, number of nodes
+        - graph, constructed using AddEdge()
+
+    Output:
+        - parent, parent[v] is the parent of v in the tree rooted at 0
+        - weight, weight[v] is the weight of the tree edge (v, parent[v])
+
+    Tested Problems:
+*/
+
+template <class T> struct GomoryHu {
+    int n, levels;
+    PushRelabel <T> flow;
+    vector <int> parent, depth;
+    vector <T> weight;
+    vector <vector <int>> up;
+    vector <vector <T>> low;
+
+    GomoryHu (int n): n(n), flow(n) {}
+
+    void AddEdge (int a, int b, T cap) {
+        flow.AddEdge(a, b, cap);
+        flow.AddEdge(b, a, cap);
+    }
+
+    void Build (int threads = 1) {
+        parent.assign(n, 0), weight.assign(n, T(0));
+        threads = max(1, threads);
+        vector <PushRelabel <T>> copies(threads, flow);
+        vector <vector <int>> cuts(threads);
+        vector <T> values(threads);
+        vector <int> against(threads);
+
+        for (int s = 1; s < n; ) {
+            int k = min(threads, n - s);
+            auto work = [&](int i) {
+                against[i] = parent[s + i];
+                values[i] = copies[i].GetMinCut(s + i, against[i], cuts[i]);
+            };
+            vector <thread> pool;
+            for (int i = 1; i < k; ++i) {
+                pool.push_back(thread(work, i));
+            }
+            work(0);
+            for (auto& t : pool) {
+                t.join();
+            }
+
+            for (int i = 0; i < k && parent[s] == against[i]; ++i, ++s) {
+                weight[s] = values[i];
+                for (int v = s + 1; v < n; ++v) {
+                    if (cuts[i][v] == 0 && parent[v] == against[i]) {
+                        parent[v] = s;
+                    }
+                }
+            }
+        }
+        BuildLifting();
+    }
+
+    void BuildLifting () {
+        levels = 1;
+        while ((1 << levels) < n) {
+            levels++;
+        }
+        vector <vector <int>> children(n);
+        for (int v = 1; v < n; ++v) {
+            children[parent[v]].push_back(v);
+        }
+        depth.assign(n, 0);
+        up.assign(levels, vector <int>(n, 0)), low.assign(levels, vector <T>(n, numeric_limits <T>::max()));
+        vector <int> bfs(1, 0);
+        for (int i = 0; i < int(bfs.size()); ++i) {
+            int u = bfs[i];
+            for (auto& v : children[u]) {
+                depth[v] = depth[u] + 1;
+                up[0][v] = u, low[0][v] = weight[v];
+                bfs.push_back(v);
+            }
+        }
+        for (int k = 1; k < levels; ++k) {
+            for (int v = 0; v < n; ++v) {
+                up[k][v] = up[k - 1][up[k - 1][v]];
+                low[k][v] = min(low[k - 1][v], low[k - 1][up[k - 1][v]]);
+            }
+        }
+    }
+
+    T MinCut (int u, int v) const {
+        T ret = numeric_limits <T>::max();
+        if (depth[u] < depth[v]) {
+            swap(u, v);
+        }
+        for (int k = levels - 1; k >= 0; --k) {
+            if (depth[u] - (1 << k) >= depth[v]) {
+                ret = min(ret, low[k][u]);
+                u = up[k][u];
+            }
+        }
+        for (int k = levels - 1; k >= 0 && u != v; --k) {
+            if (up[k][u] != up[k][v]) {
+                ret = min(ret, min(low[k][u], low[k][v]));
+                u = up[k][u], v = up[k][v];
+            }
+        }
+        if (u != v) {
+            ret = min(ret, min(low[0][u], low[0][v]));
+        }
+        return ret;
+    }
+};
+
+/*
+    Implementation of Lengauer-Tarjan dominator tree algorithm, without recursion
+
+    Running time:
+        O(|E|log|V|)
+
+    Usage:
+        - add edges by AddEdge(), they are merged into successor and predecessor CSRGraphs on the next
+        Build(), so edges can be added between calls and calls without new edges reuse the adjacency
+        - Build (root) computes the immediate dominators of every node reachable from root
+        - the DFS and the path compression of Eval() use explicit stacks, so deep chains are safe
+
+    Input:
+        - n, number of nodes
+        - graph, constructed using AddEdge()
+        - root
+
+    Output:
+        - idom, idom[v] is the immediate dominator of v (root for root, -1 if v is unreachable)
+        - order, nodes reachable from root in DFS preorder
+
+    Tested Problems:
+*/
+
+struct DominatorTree {
+    int n;
+    CSRGraph <> succ, pred;
+    vector <int> idom, order;
+    vector <int> num, dfsParent, semi, label, ancestor, path;
+
+    DominatorTree (int n): n(n), succ(n), pred(n) {}
+
+    void AddEdge (int a, int b) {
+        succ.AddEdge(a, b), pred.AddEdge(b, a);
+    }
+
+    // works on preorder numbers, returns the number with minimum semi on the compressed path to v
+    int Eval (int v) {
+        if (ancestor[v] == -1) {
+            return v;
+        }
+        path.clear();
+        for (int u = v; ancestor[ancestor[u]] != -1; u = ancestor[u]) {
+            path.push_back(u);
+        }
+        for (int i = int(path.size()) - 1; i >= 0; --i) {
+            int u = path[i], a = ancestor[u];
+            if (semi[label[a]] < semi[label[u]]) {
+                label[u] = label[a];
+            }
+            ancestor[u] = ancestor[a];
+        }
+        return label[v];
+    }
+
+    void Build (int root) {
+        succ.Flush(), pred.Flush();
+        num.assign(n, -1), order.clear(), dfsParent.clear();
+
+        vector <pair <int, const uint32_t *>> st(1, make_pair(root, succ.Begin(root)));
+        num[root] = 0, order.push_back(root), dfsParent.push_back(-1);
+        while (!st.empty()) {
+            int u = st.back().x;
+            if (st.back().y == succ.End(u)) {
+                st.pop_back();
+                continue;
+            }
+            int v = *st.back().y++;
+            if (num[v] == -1) {
+                num[v] = order.size();
+                order.push_back(v), dfsParent.push_back(num[u]);
+                st.push_back(make_pair(v, succ.Begin(v)));
+            }
+        }
+
+        int N = order.size();
+        semi.resize(N), label.resize(N), ancestor.assign(N, -1);
+        vector <int> dom(N, 0), bucketHead(N, -1), bucketNext(N, -1);
+        for (int i = 0; i < N; ++i) {
+            semi[i] = label[i] = i;
+        }
+        for (int w = N - 1; w > 0; --w) {
+            int x = order[w];
+            for (const uint32_t *it = pred.Begin(x); it != pred.End(x); ++it) {
+                if (num[*it] != -1) {
+                    semi[w] = min(semi[w], semi[Eval(num[*it])]);
+                }
+            }
+            bucketNext[w] = bucketHead[semi[w]], bucketHead[semi[w]] = w;
+            int p = dfsParent[w];
+            ancestor[w] = p;
+            for (int v = bucketHead[p]; v != -1; v = bucketNext[v]) {
+                int u = Eval(v);
+                dom[v] = semi[u] < semi[v] ? u : p;
+            }
+            bucketHead[p] = -1;
+        }
+        for (int w = 1; w < N; ++w) {
+            if (dom[w] != semi[w]) {
+                dom[w] = dom[dom[w]];
+            }
+        }
+
+        idom.assign(n, -1);
+        idom[root] = root;
+        for (int w = 1; w < N; ++w) {
+            idom[order[w]] = order[dom[w]];
+        }
+    }
+};
+
+/*
+    Transitive closure and transitive reduction of a directed graph, on word-parallel bitsets over
+    the condensation built by StronglyConnectedComponents
+
+    Running time:
+        O(|V| + |E| + C * E_c / 64), C is the number of components and E_c the number of edges
+        between components
+
+    Usage:
+        - add edges by AddEdge(), call Build()
+        - components are processed in reverse topological order (the order Tarjan emits them), the
+        successors of a component in topological order, so a successor already covered by the
+        closure is exactly a redundant edge
+        - Reaches (u, v) is true iff there is a path from u to v (u reaches itself)
+
+    Input:
+        - n, number of nodes
+        - graph, constructed using AddEdge()
+
+    Output:
+        - closure, number of ordered pairs (u, v), u != v, such that v is reachable from u
+        - reduction, number of edges of a minimum graph with the same closure
+        (a cycle inside every component of size >= 2 plus the reduced edges between components)
+        - reduced, edges (i, j) between components of the transitive reduction of the condensation
+        - reach, reach[i * words + (j / 64)] >> (j % 64) & 1 iff component j is reachable from component i
+
+    Tested Problems:
+        - UVA: 12017
+*/
+
+struct TransitiveClosure {
+    int n, words;
+    StronglyConnectedComponents scc;
+    vector <uint64_t> reach;
+    vector <pair <int, int>> reduced;
+    long long closure, reduction;
+
+    TransitiveClosure (int n): n(n), scc(n) {}
+
+    void AddEdge (int a, int b) {
+        scc.AddEdge(a, b);
+    }
+
+    void Build () {
+        scc.BuildSCC();
+        int C = scc.totalComponents;
+        words = (C + 63) / 64;
+        reach.assign(size_t(C) * words, 0);
+        reduced.clear();
+        closure = reduction = 0;
+
+        vector <int> successors, mark(C, -1);
+        for (int i = 0; i < C; ++i) {
+            successors.clear();
+            for (auto& u : scc.components[i]) {
+                for (auto& v : scc.adj[u]) {
+                    int j = scc.componentOf[v];
+                    if (j != i && mark[j] != i) {
+                        mark[j] = i;
+                        successors.push_back(j);
+                    }
+                }
+            }
+            sort(successors.begin(), successors.end(), greater <int>());
+
+            uint64_t *ri = &reach[size_t(i) * words];
+            ri[i >> 6] |= 1ULL << (i & 63);
+            for (auto& j : successors) {
+                if (ri[j >> 6] >> (j & 63) & 1) {
+                    continue;
+                }
+                reduced.push_back(make_pair(i, j));
+                const uint64_t *rj = &reach[size_t(j) * words];
+                for (int k = 0; k <= (j >> 6); ++k) {
+                    ri[k] |= rj[k];
+                }
+            }
+
+            long long size = scc.components[i].size(), below = 0;
+            for (int k = 0; k < words; ++k) {
+                for (uint64_t w = ri[k]; w; w &= w - 1) {
+                    below += scc.components[(k << 6) | __builtin_ctzll(w)].size();
+                }
+            }
+            closure += size * (below - 1);
+            reduction += size >= 2 ? size : 0;
+        }
+        reduction += reduced.size();
+    }
+
+    bool Reaches (int u, int v) const {
+        int i = scc.componentOf[u], j = scc.componentOf[v];
+        return reach[size_t(i) * words + (j >> 6)] >> (j & 63) & 1;
+    }
+};
@@ -34,4 +34,137 @@ int LexicographicallySmallestRotation (string& s) {
         }
     }
     return k;
-}
\ No newline at end of file
+}
+
+/*
+    Implementation of Aho-Corasick multi-pattern matching automaton
+
+    Running time:
+        O(L * sigma) to build, where L is the total length of the patterns and sigma the number of
+        distinct bytes in the patterns, O(1) per byte of text plus O(1) per reported match
+
+    Usage:
+        - add patterns by AddPattern(), call Build()
+        - bytes are first mapped to classes (0 for bytes that occur in no pattern), so the dense goto
+        table has only sigma + 1 columns. The trie of the patterns is built in that table, failure links
+        are computed by BFS and missing transitions are filled in, which gives a DFA
+        - dict links jump to the nearest proper suffix that ends a pattern, so only states that
+        really have an output are followed
+        - Feed (buffer, length, report) scans the next chunk of the stream, the automaton state is kept
+        between calls, so matches across chunk boundaries are found. report (id, end) is called for every
+        match of pattern id ending at stream offset end (exclusive)
+        - Reset () starts a new stream
+        - the goto table is limited to 2^31 entries
+
+    Input:
+        - patterns, non-empty strings, constructed using AddPattern()
+
+    Output:
+        - id of the pattern (in the order of AddPattern() calls) and end offset of every match
+
+    Tested Problems:
+*/
+
+struct AhoCorasick {
+    int sigma;
+    vector <string> patterns;
+    vector <int> cls, term, nextSame;
+    vector <uint32_t> go, fail, dict;
+    vector <char> hit;
+    uint32_t state;
+    long long offset;
+
+    AhoCorasick (): sigma(1), cls(256, 0), state(0), offset(0) {}
+
+    int AddPattern (const string& p) {
+        patterns.push_back(p);
+        return patterns.size() - 1;
+    }
+
+    void Build () {
+        sigma = 1;
+        fill(cls.begin(), cls.end(), 0);
+        for (auto& p : patterns) {
+            for (auto& ch : p) {
+                if (!cls[(unsigned char) ch]) {
+                    cls[(unsigned char) ch] = sigma++;
+                }
+            }
+        }
+
+        go.assign(sigma, 0), term.assign(1, -1), nextSame.assign(patterns.size(), -1);
+        for (int id = 0; id < int(patterns.size()); ++id) {
+            uint32_t u = 0;
+            for (auto& ch : patterns[id]) {
+                int c = cls[(unsigned char) ch];
+                if (!go[u * sigma + c]) {
+                    go[u * sigma + c] = term.size();
+                    term.push_back(-1);
+                    go.resize(go.size() + sigma, 0);
+                }
+                u = go[u * sigma + c];
+            }
+            if (u) {
+                nextSame[id] = term[u], term[u] = id;
+            }
+        }
+
+        int nodes = term.size();
+        fail.assign(nodes, 0), dict.assign(nodes, 0), hit.assign(nodes, 0);
+        vector <uint32_t> q;
+        q.reserve(nodes);
+        for (int c = 0; c < sigma; ++c) {
+            if (go[c]) {
+                q.push_back(go[c]);
+            }
+        }
+        for (size_t i = 0; i < q.size(); ++i) {
+            uint32_t u = q[i];
+            hit[u] = term[u] != -1 || dict[u] != 0;
+            for (int c = 0; c < sigma; ++c) {
+                uint32_t& v = go[u * sigma + c];
+                uint32_t f = go[fail[u] * sigma + c];
+                if (v) {
+                    fail[v] = f;
+                    dict[v] = term[f] != -1 ? f : dict[f];
+                    q.push_back(v);
+                } else {
+                    v = f;
+                }
+            }
+        }
+
+        // the scan loop works on row offsets with the output flag in the top bit, so every byte
+        // costs one table lookup and no multiplication
+        for (auto& v : go) {
+            v = v * sigma | uint32_t(hit[v]) << 31;
+        }
+        Reset();
+    }
+
+    void Reset () {
+        state = 0, offset = 0;
+    }
+
+    template <class F> void Feed (const char *buffer, size_t length, F report) {
+        const uint32_t *g = go.data();
+        const int *c = cls.data();
+        uint32_t u = state;
+        for (size_t i = 0; i < length; ++i) {
+            uint32_t x = g[u + c[(unsigned char) buffer[i]]];
+            u = x & 0x7fffffff;
+            if (x >> 31) {
+                for (uint32_t v = u / sigma; v; v = dict[v]) {
+                    for (int id = term[v]; id != -1; id = nextSame[id]) {
+                        report(id, offset + i + 1);
+                    }
+                }
+            }
+        }
+        state = u, offset += length;
+    }
+
+    template <class F> void Feed (const string& buffer, F report) {
+        Feed(buffer.data(), buffer.size(), report);
+    }
+};
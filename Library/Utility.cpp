@@ -114,3 +114,299 @@ struct Range {
         return !(lhs == rhs);
     }
 };
+
+/*
+    Implementation of buffered input reader working directly on raw read() blocks
+
+    Usage:
+        - requires <unistd.h>
+        - FastInput in; then read like cin, without any locale or stream state overhead:
+            int n;
+            while (in >> n) { ... }
+        - Read(x) returns false on end of file or if the next token is not a number, Line(s) reads the rest of the current line
+        - integers, floating point numbers, char (first non-space character) and string tokens are supported
+
+    Input:
+        - fd, file descriptor to read from, default is stdin
+        - size, size of the buffer
+*/
+
+struct FastInput {
+    int fd;
+    vector <char> buf;
+    size_t pos, len;
+    bool failed;
+
+    FastInput (int fd = 0, size_t size = 1 << 16): fd(fd), buf(size), pos(0), len(0), failed(false) {}
+
+    inline int Peek () {
+        if (pos == len) {
+            ssize_t r = read(fd, buf.data(), buf.size());
+            pos = 0, len = r > 0 ? r : 0;
+            if (len == 0) {
+                return -1;
+            }
+        }
+        return (unsigned char) buf[pos];
+    }
+
+    inline int Get () {
+        int c = Peek();
+        pos += c != -1;
+        return c;
+    }
+
+    inline bool SkipSpace () {
+        int c;
+        while ((c = Peek()) != -1 && c <= ' ') {
+            pos++;
+        }
+        return c != -1;
+    }
+
+    template <class T> typename enable_if <is_integral <T>::value, bool>::type Read (T& x) {
+        if (!SkipSpace()) {
+            return false;
+        }
+        bool neg = false;
+        if (Peek() == '-' || Peek() == '+') {
+            neg = Get() == '-';
+        }
+        typename make_unsigned <T>::type r = 0;
+        size_t digits = 0;
+        for (int c = Peek(); '0' <= c && c <= '9'; c = Peek()) {
+            r = r * 10 + (c - '0');
+            pos++, digits++;
+        }
+        x = neg ? T(-r) : T(r);
+        return digits > 0;
+    }
+
+    template <class T> typename enable_if <is_floating_point <T>::value, bool>::type Read (T& x) {
+        if (!SkipSpace()) {
+            return false;
+        }
+        bool neg = false;
+        if (Peek() == '-' || Peek() == '+') {
+            neg = Get() == '-';
+        }
+        long double r = 0, scale = 1;
+        size_t digits = 0;
+        int c;
+        for (c = Peek(); '0' <= c && c <= '9'; c = Peek()) {
+            r = r * 10 + (c - '0');
+            pos++, digits++;
+        }
+        if (c == '.') {
+            pos++;
+            for (c = Peek(); '0' <= c && c <= '9'; c = Peek()) {
+                r = r * 10 + (c - '0');
+                scale *= 10;
+                pos++, digits++;
+            }
+        }
+        // the exponent must follow the e directly, like strtod, a missing one is a parse failure
+        if (digits > 0 && (c == 'e' || c == 'E')) {
+            pos++;
+            bool negExp = false;
+            if (Peek() == '-' || Peek() == '+') {
+                negExp = Get() == '-';
+            }
+            int e = 0, expDigits = 0;
+            for (c = Peek(); '0' <= c && c <= '9'; c = Peek()) {
+                e = min(e * 10 + (c - '0'), 100000);
+                pos++, expDigits++;
+            }
+            if (expDigits == 0) {
+                return false;
+            }
+            r *= powl(10.0L, negExp ? -e : e);
+        }
+        x = T((neg ? -r : r) / scale);
+        return digits > 0;
+    }
+
+    bool Read (char& x) {
+        if (!SkipSpace()) {
+            return false;
+        }
+        x = Get();
+        return true;
+    }
+
+    bool Read (string& x) {
+        if (!SkipSpace()) {
+            return false;
+        }
+        x.clear();
+        for (int c = Peek(); c > ' '; c = Peek()) {
+            x.push_back(c);
+            pos++;
+        }
+        return true;
+    }
+
+    bool Line (string& x) {
+        x.clear();
+        int c = Get();
+        if (c == -1) {
+            return false;
+        }
+        for (; c != -1 && c != '\n'; c = Get()) {
+            x.push_back(c);
+        }
+        if (!x.empty() && x.back() == '\r') {
+            x.pop_back();
+        }
+        return true;
+    }
+
+    template <class T> FastInput& operator >> (T& x) {
+        failed = failed || !Read(x);
+        return *this;
+    }
+
+    explicit operator bool () const {
+        return !failed;
+    }
+};
+
+/*
+    Implementation of buffered output writer with to_chars based number formatting
+
+    Usage:
+        - requires <unistd.h> and <charconv>
+        - FastOutput out; then write like cout: out << n << ' ' << x << '\n';
+        - nothing is flushed until the buffer is full, Flush() is called or the writer is destroyed,
+        use out << flush (or endl) when interleaving with interactive judges
+        - precision, number of digits after the decimal point for floating point numbers,
+        -1 for the shortest representation that round-trips
+        - print(out, a, b, c) writes space separated values followed by a newline, without flushing
+
+    Input:
+        - fd, file descriptor to write to, default is stdout
+        - size, size of the buffer
+*/
+
+struct FastOutput {
+    int fd;
+    vector <char> buf;
+    size_t len;
+    int precision;
+
+    FastOutput (int fd = 1, size_t size = 1 << 16): fd(fd), buf(max(size, size_t(64))), len(0), precision(-1) {}
+
+    void Flush () {
+        for (size_t done = 0; done < len; ) {
+            ssize_t w = write(fd, buf.data() + done, len - done);
+            if (w <= 0) {
+                break;
+            }
+            done += w;
+        }
+        len = 0;
+    }
+
+    // makes sure at least k bytes are free in the buffer
+    inline void Reserve (size_t k) {
+        if (len + k > buf.size()) {
+            Flush();
+        }
+    }
+
+    inline void Write (char c) {
+        Reserve(1);
+        buf[len++] = c;
+    }
+
+    void Write (const char *s, size_t k) {
+        if (k > buf.size()) {
+            Flush();
+            for (size_t done = 0; done < k; ) {
+                ssize_t w = write(fd, s + done, k - done);
+                if (w <= 0) {
+                    break;
+                }
+                done += w;
+            }
+            return;
+        }
+        Reserve(k);
+        memcpy(buf.data() + len, s, k);
+        len += k;
+    }
+
+    void Write (const char *s) {
+        Write(s, strlen(s));
+    }
+
+    void Write (const string& s) {
+        Write(s.data(), s.size());
+    }
+
+    // like cout, signed and unsigned char (int8_t, uint8_t) are written as characters
+    void Write (signed char c) {
+        Write(char(c));
+    }
+
+    void Write (unsigned char c) {
+        Write(char(c));
+    }
+
+    // like cout, without boolalpha
+    void Write (bool x) {
+        Write(char('0' + x));
+    }
+
+    template <class T> typename enable_if <is_integral <T>::value>::type Write (T x) {
+        Reserve(24);
+        len = to_chars(buf.data() + len, buf.data() + buf.size(), x).ptr - buf.data();
+    }
+
+    template <class T> typename enable_if <is_floating_point <T>::value>::type Write (T x) {
+        char tmp[384];
+        auto r = precision < 0 ? to_chars(tmp, tmp + sizeof(tmp), x)
+                 : to_chars(tmp, tmp + sizeof(tmp), x, chars_format::fixed, precision);
+        Write(tmp, r.ptr - tmp);
+    }
+
+    template <class T> void Write (const vector <T>& v) {
+        for (size_t i = 0; i < v.size(); ++i) {
+            if (i) {
+                Write(' ');
+            }
+            Write(v[i]);
+        }
+    }
+
+    template <class T> FastOutput& operator << (const T& x) {
+        Write(x);
+        return *this;
+    }
+
+    // endl writes a newline and flushes, ends writes a null character, any other manipulator only flushes
+    FastOutput& operator << (ostream& (*manipulator)(ostream&)) {
+        if (manipulator == static_cast <ostream& (*)(ostream&)>(endl)) {
+            Write('\n');
+        } else if (manipulator == static_cast <ostream& (*)(ostream&)>(ends)) {
+            Write('\0');
+        }
+        Flush();
+        return *this;
+    }
+
+    ~FastOutput () {
+        Flush();
+    }
+};
+
+// variadic print function on top of FastOutput, ends the line without flushing
+template <typename Head>
+void print (FastOutput& out, Head&& head) {
+    out << head << '\n';
+}
+template <typename Head, typename... Tail>
+void print (FastOutput& out, Head&& head, Tail&& ... tail) {
+    out << head << ' ';
+    print(out, tail...);
+}